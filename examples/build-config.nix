@@ -16,6 +16,14 @@
   
   # Per-module overrides
   moduleOverrides = {
+    "math-utils" = {
+      # Hot numeric code; march is left unset so the flake builds on every system
+      optimization = {
+        level = "3";
+        noPlt = true;
+        defines.EIGEN_MAX_ALIGN_BYTES = 32;
+      };
+    };
     "network" = {
       buildType = "release";  # Network module always optimized
     };
@@ -0,0 +1,147 @@
+// Compile LOG_DEBUG out to measure the cost of a disabled call site
+#define LOGGER_ACTIVE_LEVEL LOGGER_LEVEL_INFO
+#include "logger/logger.hpp"
+#include "logger/binary_sink.hpp"
+#include "logger/buffered_file_sink.hpp"
+#include "logger/metrics.hpp"
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/null_sink.h>
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+using namespace logger;
+
+// Logger throughput by sink and thread count. Every benchmark logs through
+// one logger shared by all benchmark threads; items/s is messages/s.
+
+namespace {
+
+enum class SinkKind {
+    Null,      // Front-end cost only: level check and payload formatting
+    Basic,     // basic_file_sink_mt with flush_on(err), as CreateLogger sets up
+    Buffered,  // BufferedFileSink
+    Binary,    // BinaryFileSink
+    Captured,  // BinaryFileSink with CaptureArguments: no formatting at all
+    Metered    // Null sink behind a MeteredSink, logger registered for metrics
+};
+
+const std::string kLogBase = "logger_bench";
+
+std::shared_ptr<spdlog::logger> makeLogger(SinkKind kind) {
+    spdlog::sink_ptr sink;
+    switch (kind) {
+        case SinkKind::Null:
+            sink = std::make_shared<spdlog::sinks::null_sink_mt>();
+            break;
+        case SinkKind::Basic:
+            sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(kLogBase + ".log", true);
+            break;
+        case SinkKind::Buffered:
+            sink = std::make_shared<BufferedFileSink>(kLogBase + ".log", true);
+            break;
+        case SinkKind::Binary:
+        case SinkKind::Captured:
+            sink = std::make_shared<BinaryFileSink>(kLogBase);
+            break;
+        case SinkKind::Metered:
+            sink = std::make_shared<MeteredSink>(std::make_shared<spdlog::sinks::null_sink_mt>(), "null");
+            break;
+    }
+    if (kind != SinkKind::Binary && kind != SinkKind::Captured) {
+        sink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%n] [%l] %v");
+    }
+    auto log = std::make_shared<spdlog::logger>("Bench", sink);
+    log->set_level(spdlog::level::info);
+    if (kind == SinkKind::Basic) {
+        log->flush_on(spdlog::level::err);
+    }
+    if (kind == SinkKind::Metered) {
+        detail::registerMetrics(log, nullptr);
+    }
+    if (kind == SinkKind::Captured) {
+        CaptureArguments(log);
+    }
+    return log;
+}
+
+// Created by thread 0 before the timed region; the other benchmark
+// threads only start timing once it exists
+std::shared_ptr<spdlog::logger> shared;
+
+void setUp(const benchmark::State& state, SinkKind kind) {
+    if (state.thread_index() == 0) {
+        shared = makeLogger(kind);
+    }
+}
+
+void tearDown(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        shared->flush();
+        shared.reset();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+// Enabled messages; every 16th is an error
+static void BM_LogEnabled(benchmark::State& state, SinkKind kind) {
+    setUp(state, kind);
+    const int thread = state.thread_index();
+    int i = 0;
+    for (auto _ : state) {
+        if (++i % 16 == 0) {
+            LOG_ERROR(shared, "thread {} failed item {} with code {}", thread, i, 42);
+        } else {
+            LOG_INFO(shared, "thread {} processed item {} in {:.3f} ms", thread, i, 0.125);
+        }
+    }
+    tearDown(state);
+}
+BENCHMARK_CAPTURE(BM_LogEnabled, Null, SinkKind::Null)->Threads(1)->Threads(8)->Threads(32)->UseRealTime();
+BENCHMARK_CAPTURE(BM_LogEnabled, Basic, SinkKind::Basic)->Threads(1)->Threads(8)->Threads(32)->UseRealTime();
+BENCHMARK_CAPTURE(BM_LogEnabled, Buffered, SinkKind::Buffered)->Threads(1)->Threads(8)->Threads(32)->UseRealTime();
+BENCHMARK_CAPTURE(BM_LogEnabled, Binary, SinkKind::Binary)->Threads(1)->Threads(8)->Threads(32)->UseRealTime();
+BENCHMARK_CAPTURE(BM_LogEnabled, Captured, SinkKind::Captured)->Threads(1)->Threads(8)->Threads(32)->UseRealTime();
+// Null plus the cost of call-site timing and sink counters
+BENCHMARK_CAPTURE(BM_LogEnabled, Metered, SinkKind::Metered)->Threads(1)->Threads(8)->Threads(32)->UseRealTime();
+
+// Below the logger's runtime level: one branch, no formatting
+static void BM_LogFilteredAtRuntime(benchmark::State& state) {
+    setUp(state, SinkKind::Basic);
+    int i = 0;
+    for (auto _ : state) {
+        shared->debug("filtered item {}", ++i);
+    }
+    tearDown(state);
+}
+BENCHMARK(BM_LogFilteredAtRuntime)->Threads(1)->Threads(8)->Threads(32)->UseRealTime();
+
+// Below LOGGER_ACTIVE_LEVEL: the call site is compiled out
+static void BM_LogCompiledOut(benchmark::State& state) {
+    setUp(state, SinkKind::Basic);
+    int i = 0;
+    for (auto _ : state) {
+        LOG_DEBUG(shared, "compiled out item {}", ++i);
+        benchmark::DoNotOptimize(i);
+    }
+    tearDown(state);
+}
+BENCHMARK(BM_LogCompiledOut)->Threads(1)->Threads(8)->Threads(32)->UseRealTime();
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    std::filesystem::remove(kLogBase + ".log");
+    for (const auto& segment : ListBinaryLogSegments(kLogBase)) {
+        std::filesystem::remove(segment);
+    }
+    return 0;
+}
@@ -20,6 +20,8 @@ in mkModule {
     lib = mkLibrary {
       name = "logging";
       type = "static";
+      # Executables below reuse this PCH
+      precompileHeaders = [ "<spdlog/spdlog.h>" ];
     };
     
     # Logging demo executable
@@ -28,10 +30,34 @@ in mkModule {
       entrypoint = "tools/log_demo.cpp";
     };
     
+    # Decode binary log segments back to text
+    log-decode = mkExecutable {
+      name = "log-decode";
+      entrypoint = "tools/log_decode.cpp";
+    };
+    
     # Logger tests
     logger-tests = mkExecutable {
       name = "logger-tests";
       entrypoint = "tests/logger_test.cpp";
     };
+    
+    # Binary sink tests
+    binary-sink-tests = mkExecutable {
+      name = "binary-sink-tests";
+      entrypoint = "tests/binary_sink_test.cpp";
+    };
+    
+    # Buffered file sink tests
+    buffered-file-sink-tests = mkExecutable {
+      name = "buffered-file-sink-tests";
+      entrypoint = "tests/buffered_file_sink_test.cpp";
+    };
+    
+    # Logger metrics tests
+    metrics-tests = mkExecutable {
+      name = "metrics-tests";
+      entrypoint = "tests/metrics_test.cpp";
+    };
   };
 }
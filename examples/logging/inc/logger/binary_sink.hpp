@@ -0,0 +1,117 @@
+#pragma once
+
+#include <spdlog/details/file_helper.h>
+#include <spdlog/logger.h>
+#include <spdlog/sinks/base_sink.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace logger {
+
+// Compact binary log format written by BinaryFileSink and read back by
+// BinaryLogReader (and the log-decode tool).
+//
+// Each segment file starts with the 4-byte magic "SLOG" and a uint16
+// version, followed by records tagged with a uint8 type:
+//   LoggerName:      uint32 id, uint16 length, name bytes
+//   Message:         int64 timestamp (ns since epoch), uint8 level, uint32 logger id,
+//                    uint64 thread id, uint32 length, payload bytes
+//   FormatString:    uint32 id, uint32 length, format string bytes
+//   CapturedMessage: int64 timestamp, uint8 level, uint32 logger id, uint64 thread id,
+//                    uint32 format id, uint32 length, argument bytes
+// Captured arguments are encoded as described in captured_args.hpp. Logger
+// names and format strings are interned per segment, so every segment
+// decodes on its own. Integers use the host byte order. Version 1 files
+// (no format strings or captured messages) are still read.
+namespace binary_format {
+constexpr char kMagic[4] = {'S', 'L', 'O', 'G'};
+constexpr std::uint16_t kVersion = 2;
+constexpr std::uint8_t kLoggerNameRecord = 1;
+constexpr std::uint8_t kMessageRecord = 2;
+constexpr std::uint8_t kFormatStringRecord = 3;
+constexpr std::uint8_t kCapturedMessageRecord = 4;
+} // namespace binary_format
+
+// Writes log records without pattern formatting into size-bounded segment
+// files named "<basePath>.<n>.logb"; timestamp, level and logger are stored
+// raw. Messages from LOG_* calls on a CaptureArguments logger are stored as
+// format string id and raw arguments, so nothing is formatted on the
+// producer side; other messages keep the payload formatted by the logger.
+class BinaryFileSink : public spdlog::sinks::base_sink<std::mutex> {
+public:
+    explicit BinaryFileSink(std::string basePath, std::size_t segmentBytes = 64 * 1024 * 1024);
+
+    static std::string segmentPath(const std::string& basePath, std::size_t index);
+
+    // Bytes written across all segments, headers and name records included
+    std::uint64_t bytesWritten() const { return bytesWritten_.load(std::memory_order_relaxed); }
+
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void flush_() override;
+
+private:
+    void openSegment(std::size_t index);
+    std::uint32_t internLogger(spdlog::string_view_t name);
+    void internFormat(std::uint32_t id);
+
+    std::string basePath_;
+    std::size_t segmentBytes_;
+    std::size_t segmentIndex_ = 0;
+    std::size_t segmentSize_ = 0;
+    spdlog::details::file_helper file_;
+    spdlog::memory_buf_t record_;
+    std::unordered_map<std::string, std::uint32_t> loggerIds_;
+    std::unordered_set<std::uint32_t> formatIds_;
+    std::atomic<std::uint64_t> bytesWritten_{0};
+};
+
+struct BinaryRecord {
+    std::int64_t timestampNs = 0;
+    spdlog::level::level_enum level = spdlog::level::info;
+    std::string loggerName;
+    std::uint64_t threadId = 0;
+    std::string payload;
+};
+
+// Sequential reader for one segment file; throws std::runtime_error on a
+// malformed or truncated file. Captured messages are formatted here, so
+// `payload` reads the same for both message kinds.
+class BinaryLogReader {
+public:
+    explicit BinaryLogReader(const std::string& path);
+
+    // Reads the next message record; returns false at end of file
+    bool next(BinaryRecord& record);
+
+private:
+    void readBytes(void* out, std::size_t size);
+
+    std::ifstream in_;
+    std::unordered_map<std::uint32_t, std::string> loggerNames_;
+    std::unordered_map<std::uint32_t, std::string> formatStrings_;
+    std::string arguments_;
+};
+
+// Makes LOG_* calls on `logger` record their format string id and raw
+// arguments instead of a formatted payload. Every sink of the logger must be
+// a BinaryFileSink, directly or behind a MeteredSink; throws
+// std::invalid_argument otherwise. CreateLogger and LoggerFactory call it
+// for binary loggers without console or extra sinks.
+void CaptureArguments(const std::shared_ptr<spdlog::logger>& logger);
+
+// Existing segment files for a sink base path, in write order
+std::vector<std::string> ListBinaryLogSegments(const std::string& basePath);
+
+// Render a record in the same layout as the text file sink
+std::string FormatBinaryRecord(const BinaryRecord& record);
+
+} // namespace logger
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "logger/logger.hpp"
+#include <spdlog/formatter.h>
+#include <spdlog/sinks/sink.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace logger {
+
+// Text file sink where each logging thread formats into its own buffer and
+// a background writer thread appends the buffers to the file in batches.
+// Producers only take their own, normally uncontended, buffer lock, so
+// concurrent threads no longer serialize on one sink mutex and one write()
+// per message.
+//
+// Lines from one thread keep their order; lines from different threads are
+// interleaved in batch-sized runs rather than strictly by time.
+class BufferedFileSink : public spdlog::sinks::sink {
+public:
+    BufferedFileSink(const std::string& filename, bool truncate, BufferedSinkOptions options = {});
+    ~BufferedFileSink() override;
+
+    BufferedFileSink(const BufferedFileSink&) = delete;
+    BufferedFileSink& operator=(const BufferedFileSink&) = delete;
+
+    void log(const spdlog::details::log_msg& msg) override;
+
+    // Writes every thread's buffered lines to the OS before returning
+    void flush() override;
+
+    void set_pattern(const std::string& pattern) override;
+    void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+    // Writes of buffered lines not requested through flush(): batches from
+    // the writer thread and FsyncOnCritical writes, counted when they wrote
+    // anything, and the total time they took
+    std::uint64_t batchWrites() const { return batchWrites_.load(std::memory_order_relaxed); }
+    std::chrono::nanoseconds batchWriteTime() const {
+        return std::chrono::nanoseconds(batchWriteNs_.load(std::memory_order_relaxed));
+    }
+
+private:
+    struct ThreadBuffer {
+        std::mutex mutex;
+        spdlog::memory_buf_t data;
+        std::unique_ptr<spdlog::formatter> formatter;
+        std::uint64_t formatterVersion = 0;
+    };
+
+    ThreadBuffer& localBuffer();
+    void wakeWriter();
+    void writerLoop();
+    std::size_t drain(bool sync);
+    void drainBatch(bool sync);
+
+    const std::uint64_t id_;
+    // Expires with the sink; lets threads drop buffers of destroyed sinks
+    const std::shared_ptr<const char> lifetime_ = std::make_shared<const char>();
+    const BufferedSinkOptions options_;
+    std::FILE* file_ = nullptr;
+
+    // Formatter template cloned into each thread buffer when it changes
+    std::mutex formatterMutex_;
+    std::unique_ptr<spdlog::formatter> formatter_;
+    std::atomic<std::uint64_t> formatterVersion_{1};
+
+    std::mutex buffersMutex_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+
+    // Serializes drains from the writer thread and explicit flushes
+    std::mutex writeMutex_;
+    spdlog::memory_buf_t spare_;
+    std::atomic<std::uint64_t> batchWrites_{0};
+    std::atomic<std::uint64_t> batchWriteNs_{0};
+
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    bool pending_ = false;
+    bool stop_ = false;
+    std::thread writer_;
+};
+
+} // namespace logger
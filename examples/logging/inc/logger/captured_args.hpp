@@ -0,0 +1,156 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace logger {
+
+namespace detail {
+
+// Argument capture behind LOGGER_LOG. For loggers registered with
+// CaptureArguments (see binary_sink.hpp) an enabled LOG_* call does not
+// format its message: it passes its call site's format string id and the
+// raw argument values to the sinks, and the decoder formats them offline.
+//
+// The captured payload is a uint32 format id followed by one tagged value
+// per argument, in host byte order:
+//   Bool, Char: 1 byte   Int: int64   UInt: uint64   Float: float
+//   Double: double       String: uint32 length, bytes
+// Messages carrying it are marked by kCapturedArguments as the source
+// function name.
+enum class ArgType : std::uint8_t {
+    Bool = 1,
+    Char = 2,
+    Int = 3,
+    UInt = 4,
+    Float = 5,
+    Double = 6,
+    String = 7
+};
+
+inline constexpr char kCapturedArguments[] = "<captured arguments>";
+
+template <typename T>
+inline constexpr bool isCharType = std::is_same_v<T, wchar_t> || std::is_same_v<T, char8_t> ||
+                                   std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>;
+
+// Argument types stored raw. Anything else (user types with an fmt
+// formatter, long double, pointers other than C strings) makes the call
+// format as usual.
+template <typename T>
+concept CapturableArg =
+    (std::is_arithmetic_v<T> && !std::is_same_v<T, long double> && !isCharType<T>) ||
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+    std::is_same_v<T, const char*> || std::is_same_v<T, char*> ||
+    (std::is_array_v<T> && std::is_same_v<std::remove_extent_t<T>, char>);
+
+// Process-wide id of one format string, cached in a static at each call site
+struct FormatSite {
+    std::atomic<std::uint32_t> id{0};
+};
+
+// Interns `format`; equal strings get the same id. Never returns 0.
+std::uint32_t registerFormat(spdlog::string_view_t format);
+
+// Format string registered under `id`; empty for unknown ids
+std::string formatString(std::uint32_t id);
+
+bool capturesArguments(const spdlog::logger& logger) noexcept;
+
+inline std::uint32_t formatId(FormatSite& site, spdlog::string_view_t format) {
+    std::uint32_t id = site.id.load(std::memory_order_acquire);
+    if (id == 0) {
+        id = registerFormat(format);
+        site.id.store(id, std::memory_order_release);
+    }
+    return id;
+}
+
+template <typename T>
+void appendRaw(spdlog::memory_buf_t& buf, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buf.append(bytes, bytes + sizeof(T));
+}
+
+// Null C strings are left to fmt, which reports them
+template <typename T>
+bool capturable(const T& value) {
+    if constexpr (std::is_pointer_v<T>) {
+        return value != nullptr;
+    } else {
+        return true;
+    }
+}
+
+template <typename T>
+void encodeArg(spdlog::memory_buf_t& buf, const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        appendRaw(buf, ArgType::Bool);
+        appendRaw(buf, static_cast<std::uint8_t>(value));
+    } else if constexpr (std::is_same_v<T, char>) {
+        appendRaw(buf, ArgType::Char);
+        appendRaw(buf, value);
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        appendRaw(buf, ArgType::Int);
+        appendRaw(buf, static_cast<std::int64_t>(value));
+    } else if constexpr (std::is_integral_v<T>) {
+        appendRaw(buf, ArgType::UInt);
+        appendRaw(buf, static_cast<std::uint64_t>(value));
+    } else if constexpr (std::is_same_v<T, float>) {
+        appendRaw(buf, ArgType::Float);
+        appendRaw(buf, value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        appendRaw(buf, ArgType::Double);
+        appendRaw(buf, static_cast<double>(value));
+    } else {
+        const std::string_view text(value);
+        appendRaw(buf, ArgType::String);
+        appendRaw(buf, static_cast<std::uint32_t>(text.size()));
+        buf.append(text.data(), text.data() + text.size());
+    }
+}
+
+template <typename... Args>
+void logCaptured(spdlog::logger& logger, spdlog::source_loc loc, spdlog::level::level_enum level,
+                 std::uint32_t id, const Args&... args) {
+    spdlog::memory_buf_t payload;
+    appendRaw(payload, id);
+    (encodeArg(payload, args), ...);
+    logger.log(spdlog::source_loc{loc.filename, loc.line, kCapturedArguments}, level,
+               spdlog::string_view_t(payload.data(), payload.size()));
+}
+
+// Entry points of LOGGER_LOG, mirroring spdlog::logger::log overloads
+template <typename... Args>
+void logCall(FormatSite& site, spdlog::logger& logger, spdlog::source_loc loc, spdlog::level::level_enum level,
+             spdlog::format_string_t<Args...> format, Args&&... args) {
+    if constexpr ((CapturableArg<std::remove_cvref_t<Args>> && ...)) {
+        if (capturesArguments(logger) && (capturable(args) && ...)) {
+            const spdlog::string_view_t text = format;
+            logCaptured(logger, loc, level, formatId(site, text), args...);
+            return;
+        }
+    }
+    logger.log(loc, level, format, std::forward<Args>(args)...);
+}
+
+template <typename T>
+void logCall(FormatSite& site, spdlog::logger& logger, spdlog::source_loc loc, spdlog::level::level_enum level,
+             const T& msg) {
+    if constexpr (CapturableArg<T>) {
+        if (capturesArguments(logger) && capturable(msg)) {
+            logCaptured(logger, loc, level, formatId(site, "{}"), msg);
+            return;
+        }
+    }
+    logger.log(loc, level, msg);
+}
+
+} // namespace detail
+
+} // namespace logger
@@ -1,11 +1,106 @@
 #pragma once
 
+#include "logger/captured_args.hpp"
 #include <spdlog/spdlog.h>
-#include <spdlog/sinks/stdout_color_sinks.h>
-#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/sink.h>
+#include <chrono>
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
-#include <format>
+#include <unordered_map>
+#include <vector>
+
+// Compile-time log level threshold. Log macros below LOGGER_ACTIVE_LEVEL
+// expand to nothing, so neither their arguments nor any formatting are
+// evaluated. Set it per module through buildConfig.defines, e.g.
+//   buildConfig.defines.LOGGER_ACTIVE_LEVEL = "LOGGER_LEVEL_INFO";
+#define LOGGER_LEVEL_DEBUG 0
+#define LOGGER_LEVEL_INFO 1
+#define LOGGER_LEVEL_WARNING 2
+#define LOGGER_LEVEL_ERROR 3
+#define LOGGER_LEVEL_CRITICAL 4
+#define LOGGER_LEVEL_OFF 5
+
+#ifndef LOGGER_ACTIVE_LEVEL
+#define LOGGER_ACTIVE_LEVEL LOGGER_LEVEL_DEBUG
+#endif
+
+// Call-site metrics (see metrics.hpp): enabled LOG_* calls are timed and
+// calls below the runtime level counted in per-thread counters. Build with
+// LOGGER_METRICS=0 to drop both from every call site.
+#ifndef LOGGER_METRICS
+#define LOGGER_METRICS 1
+#endif
+
+// Enabled levels check the logger's runtime level with one branch before
+// touching the arguments; formatting then happens lazily inside spdlog from
+// a compile-time checked format string:
+//   LOG_INFO(log, "Processing item {}/{}", i, total);
+// Loggers that only write binary files skip formatting altogether and
+// record the call site's format string id and raw arguments instead (see
+// captured_args.hpp).
+#if LOGGER_METRICS
+#define LOGGER_LOG(logger_ptr, level, ...)                                              \
+    do {                                                                                \
+        auto&& logger_log_target_ = (logger_ptr);                                       \
+        if (logger_log_target_->should_log(level)) {                                    \
+            const ::logger::detail::LogCallTimer logger_log_timer_(*logger_log_target_, level); \
+            static constinit ::logger::detail::FormatSite logger_log_site_;             \
+            ::logger::detail::logCall(logger_log_site_, *logger_log_target_,            \
+                                      spdlog::source_loc{__FILE__, __LINE__, SPDLOG_FUNCTION}, \
+                                      level, __VA_ARGS__);                              \
+        } else {                                                                        \
+            ::logger::detail::countFiltered(*logger_log_target_, level);                \
+        }                                                                               \
+    } while (0)
+#else
+#define LOGGER_LOG(logger_ptr, level, ...)                                              \
+    do {                                                                                \
+        auto&& logger_log_target_ = (logger_ptr);                                       \
+        if (logger_log_target_->should_log(level)) {                                    \
+            static constinit ::logger::detail::FormatSite logger_log_site_;             \
+            ::logger::detail::logCall(logger_log_site_, *logger_log_target_,            \
+                                      spdlog::source_loc{__FILE__, __LINE__, SPDLOG_FUNCTION}, \
+                                      level, __VA_ARGS__);                              \
+        }                                                                               \
+    } while (0)
+#endif
+
+#if LOGGER_ACTIVE_LEVEL <= LOGGER_LEVEL_DEBUG
+#define LOG_DEBUG(logger_ptr, ...) LOGGER_LOG(logger_ptr, spdlog::level::debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(logger_ptr, ...) (void)0
+#endif
+
+#if LOGGER_ACTIVE_LEVEL <= LOGGER_LEVEL_INFO
+#define LOG_INFO(logger_ptr, ...) LOGGER_LOG(logger_ptr, spdlog::level::info, __VA_ARGS__)
+#else
+#define LOG_INFO(logger_ptr, ...) (void)0
+#endif
+
+#if LOGGER_ACTIVE_LEVEL <= LOGGER_LEVEL_WARNING
+#define LOG_WARNING(logger_ptr, ...) LOGGER_LOG(logger_ptr, spdlog::level::warn, __VA_ARGS__)
+#else
+#define LOG_WARNING(logger_ptr, ...) (void)0
+#endif
+
+#if LOGGER_ACTIVE_LEVEL <= LOGGER_LEVEL_ERROR
+#define LOG_ERROR(logger_ptr, ...) LOGGER_LOG(logger_ptr, spdlog::level::err, __VA_ARGS__)
+#else
+#define LOG_ERROR(logger_ptr, ...) (void)0
+#endif
+
+#if LOGGER_ACTIVE_LEVEL <= LOGGER_LEVEL_CRITICAL
+#define LOG_CRITICAL(logger_ptr, ...) LOGGER_LOG(logger_ptr, spdlog::level::critical, __VA_ARGS__)
+#else
+#define LOG_CRITICAL(logger_ptr, ...) (void)0
+#endif
+
+namespace spdlog::details {
+class thread_pool;
+} // namespace spdlog::details
 
 namespace logger {
 
@@ -17,7 +112,124 @@ enum class LogLevel {
     Critical
 };
 
-// Simple logger creation function
+// What an async logger does when its queue is full
+enum class OverflowPolicy {
+    Block,           // Wait for room in the queue
+    DropNewest,      // Discard the incoming message (requires spdlog >= 1.13)
+    OverwriteOldest  // Discard the oldest queued message
+};
+
+struct AsyncOptions {
+    std::size_t queueSize = 8192;    // Bounded queue capacity in messages
+    std::size_t threadCount = 1;     // Background threads draining the queue
+    OverflowPolicy overflowPolicy = OverflowPolicy::Block;
+};
+
+// How hard a buffered file sink works to get lines onto stable storage
+enum class Durability {
+    None,            // Leave writeback to the OS
+    Periodic,        // fsync every syncInterval
+    FsyncOnCritical  // A critical message returns only after everything before it is fsync'ed
+};
+
+struct BufferedSinkOptions {
+    std::size_t flushBytes = 64 * 1024;               // Per-thread buffer size that wakes the writer
+    std::chrono::milliseconds flushInterval{100};     // Longest a line waits in a buffer
+    Durability durability = Durability::None;
+    std::chrono::milliseconds syncInterval{1000};     // Periodic durability only
+};
+
+// Encoding of the per-logger file sink
+enum class FileFormat {
+    Text,   // "<name>.log", one pattern-formatted line per message
+    Binary  // "<name>.<n>.logb" segments, see binary_sink.hpp; decode with log-decode.
+            // Without console or extra sinks, LOG_* calls store their format
+            // string id and raw arguments unformatted (CaptureArguments).
+};
+
+struct LoggerOptions {
+    FileFormat fileFormat = FileFormat::Text;
+    bool console = true;  // Also write pattern-formatted lines to stdout
+
+    // When set, the text file sink buffers per thread and writes in batches
+    // (see buffered_file_sink.hpp). Errors then no longer force a flush;
+    // durability follows the buffered sink options instead.
+    std::optional<BufferedSinkOptions> buffered;
+
+    // When set, log calls only enqueue the message; sinks run on a
+    // background thread pool owned by the logger
+    std::optional<AsyncOptions> async;
+
+    // Written to after the console and file sinks, with their own level
+    // and formatter left as configured by the caller
+    std::vector<spdlog::sink_ptr> extraSinks;
+};
+
+// Simple logger creation function. Get-or-create: if a logger with this
+// name is already registered it is returned as is (level and sinks
+// unchanged) instead of opening a new "<name>.log". Returns nullptr if
+// creation fails, except that OverflowPolicy::DropNewest throws
+// std::invalid_argument when built against spdlog older than 1.13.
 std::shared_ptr<spdlog::logger> CreateLogger(LogLevel level, const std::string& name);
+std::shared_ptr<spdlog::logger> CreateLogger(LogLevel level, const std::string& name, const LoggerOptions& options);
+
+// Creates named component loggers that all write through one sink set: a
+// single console sink and a single file sink at fileBase (format, buffering
+// and async pool chosen once by options). Open files and startup cost stay
+// flat however many loggers are created.
+class LoggerFactory {
+public:
+    // Throws std::invalid_argument for invalid options
+    explicit LoggerFactory(const std::string& fileBase, const LoggerOptions& options = {});
+
+    // Get-or-create without exceptions: repeated names return the logger
+    // already registered under that name, whichever factory created it.
+    // Returns nullptr only if creation fails.
+    std::shared_ptr<spdlog::logger> get(const std::string& name, LogLevel level = LogLevel::Info);
+
+    // The sinks shared by every logger of this factory. The console and file
+    // sinks are MeteredSink wrappers (see metrics.hpp); MeteredSink::wrapped()
+    // returns the sink underneath. Extra sinks are returned as given.
+    const std::vector<spdlog::sink_ptr>& sinks() const { return sinks_; }
+
+private:
+    LoggerOptions options_;
+    std::vector<spdlog::sink_ptr> sinks_;
+    std::shared_ptr<spdlog::details::thread_pool> pool_;
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<spdlog::logger>> loggers_;
+};
+
+// Messages an async logger discarded because its queue was full; 0 for
+// synchronous or unknown loggers. spdlog counts drops per thread pool, and
+// the loggers of one LoggerFactory share its pool, so for those this is the
+// factory-wide total rather than the named logger's own drops.
+std::size_t DroppedMessageCount(const std::string& name);
+
+namespace detail {
+
+// Hooks behind LOGGER_LOG. They update the calling thread's counters for
+// loggers created by CreateLogger or LoggerFactory and do nothing for others.
+void countFiltered(const spdlog::logger& logger, spdlog::level::level_enum level) noexcept;
+void recordLogCall(const spdlog::logger& logger, spdlog::level::level_enum level,
+                   std::chrono::steady_clock::duration elapsed) noexcept;
+
+class LogCallTimer {
+public:
+    LogCallTimer(const spdlog::logger& logger, spdlog::level::level_enum level)
+        : logger_(logger), level_(level), start_(std::chrono::steady_clock::now()) {}
+    ~LogCallTimer() { recordLogCall(logger_, level_, std::chrono::steady_clock::now() - start_); }
+
+    LogCallTimer(const LogCallTimer&) = delete;
+    LogCallTimer& operator=(const LogCallTimer&) = delete;
+
+private:
+    const spdlog::logger& logger_;
+    const spdlog::level::level_enum level_;
+    const std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace detail
 
 } // namespace logger
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "logger/logger.hpp"
+#include <spdlog/formatter.h>
+#include <spdlog/sinks/sink.h>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace logger {
+
+// Runtime metrics of loggers created by CreateLogger and LoggerFactory.
+//
+// Counters live in per-thread shards that only their own thread writes, so
+// recording is a plain load and store with no shared cache line; snapshots
+// sum the shards of every thread, including threads that have exited.
+// Logger counters come from the LOG_* macros (see LOGGER_METRICS), so
+// direct logger->info(...) calls only show up in the sink counters.
+
+// Per-level counts indexed by LogLevel (debug, info, warning, error,
+// critical); spdlog's trace level counts as Debug
+using LevelCounts = std::array<std::uint64_t, 5>;
+
+// Percentiles come from a log-linear histogram with 8 buckets per power of
+// two, so they are within 12.5% of the exact value
+struct LatencySummary {
+    std::uint64_t count = 0;
+    std::chrono::nanoseconds p50{0};
+    std::chrono::nanoseconds p99{0};
+    std::chrono::nanoseconds max{0};
+};
+
+struct SinkMetrics {
+    std::string name;                       // "console" or the file path
+    LevelCounts records{};                  // Records that passed the sink's level
+    std::uint64_t bytes = 0;                // Formatted bytes; encoded bytes for binary sinks
+    std::uint64_t flushes = 0;              // flush() calls, plus batches a buffered sink wrote on its own
+    std::chrono::nanoseconds flushTime{0};  // Total time spent in those flushes
+};
+
+struct LoggerMetrics {
+    std::string name;
+    LevelCounts emitted{};       // LOG_* calls that passed the runtime level
+    LevelCounts filtered{};      // LOG_* calls below the runtime level
+    LatencySummary logCall;      // Time in emitted LOG_* calls; async loggers only enqueue
+    std::size_t queueDepth = 0;  // Async only: messages waiting for the thread pool
+    std::size_t dropped = 0;     // As DroppedMessageCount
+    // Sinks shared through a LoggerFactory report the same totals under
+    // every logger that writes to them
+    std::vector<SinkMetrics> sinks;
+};
+
+// Current metrics of the registered logger `name`; nullopt if it was not
+// created by CreateLogger or LoggerFactory
+std::optional<LoggerMetrics> SnapshotMetrics(const std::string& name);
+
+// Every live logger created by CreateLogger or LoggerFactory, sorted by name
+std::vector<LoggerMetrics> SnapshotMetrics();
+
+// One "logger=..." line followed by one indented "sink=..." line per sink,
+// all key=value pairs with durations in nanoseconds
+std::string FormatMetrics(const LoggerMetrics& metrics);
+
+// Forwards to another sink and counts what passes through: records per
+// level, formatted bytes, flushes and time spent flushing (including the
+// batch writes of a wrapped BufferedFileSink). CreateLogger and
+// LoggerFactory wrap every sink they create in one. Bytes are counted by the
+// formatter installed through set_pattern/set_formatter, so set the pattern
+// on the wrapper rather than on the wrapped sink.
+class MeteredSink : public spdlog::sinks::sink {
+public:
+    MeteredSink(spdlog::sink_ptr sink, std::string name);
+
+    void log(const spdlog::details::log_msg& msg) override;
+    void flush() override;
+    void set_pattern(const std::string& pattern) override;
+    void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+    const spdlog::sink_ptr& wrapped() const { return sink_; }
+    SinkMetrics snapshot() const;
+
+private:
+    struct Counters;
+
+    spdlog::sink_ptr sink_;
+    const std::string name_;
+    std::shared_ptr<Counters> counters_;
+};
+
+struct MetricsDumpOptions {
+    std::string path = "logger-metrics.log";
+    std::chrono::milliseconds interval{10000};
+};
+
+// Appends FormatMetrics output for every logger to a metrics log at a fixed
+// interval from a background thread, and once more on destruction. The
+// metrics log is a plain file, so dumping never feeds back into the
+// counters it reports.
+class MetricsDumper {
+public:
+    explicit MetricsDumper(MetricsDumpOptions options = {});
+    ~MetricsDumper();
+
+    MetricsDumper(const MetricsDumper&) = delete;
+    MetricsDumper& operator=(const MetricsDumper&) = delete;
+
+    // Writes one timestamped snapshot of every logger now
+    void dump();
+
+private:
+    void run();
+
+    const MetricsDumpOptions options_;
+    std::FILE* file_ = nullptr;
+    std::mutex fileMutex_;
+
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+namespace detail {
+
+// Makes `logger` visible to SnapshotMetrics; `pool` is its async thread
+// pool, if any. Called by CreateLogger and LoggerFactory.
+void registerMetrics(const std::shared_ptr<spdlog::logger>& logger,
+                     const std::shared_ptr<spdlog::details::thread_pool>& pool);
+
+} // namespace detail
+
+} // namespace logger
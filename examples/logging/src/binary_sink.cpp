@@ -0,0 +1,427 @@
+#include "logger/binary_sink.hpp"
+#include "logger/captured_args.hpp"
+#include "logger/metrics.hpp"
+#include <fmt/args.h>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace logger {
+
+namespace {
+
+template <typename T>
+void append(spdlog::memory_buf_t& buf, const T& value) {
+    detail::appendRaw(buf, value);
+}
+
+// Format strings of every LOG_* call site that captured arguments; ids
+// index `strings` from 1
+struct FormatRegistry {
+    std::mutex mutex;
+    std::deque<std::string> strings;
+    std::unordered_map<std::string, std::uint32_t> ids;
+};
+
+FormatRegistry& formatRegistry() {
+    // Never destroyed: log calls can still arrive during static destruction
+    static auto* registry = new FormatRegistry();
+    return *registry;
+}
+
+// Loggers registered with CaptureArguments
+struct CaptureRegistry {
+    std::mutex mutex;
+    std::unordered_map<const spdlog::logger*, std::weak_ptr<spdlog::logger>> loggers;
+    // Bumped on every registration so threads drop cached negative lookups;
+    // a new logger may reuse the address of a destroyed one
+    std::atomic<std::uint64_t> generation{1};
+};
+
+CaptureRegistry& captureRegistry() {
+    static auto* registry = new CaptureRegistry();
+    return *registry;
+}
+
+bool isBinarySink(const spdlog::sink_ptr& sink) {
+    if (auto metered = std::dynamic_pointer_cast<MeteredSink>(sink)) {
+        return isBinarySink(metered->wrapped());
+    }
+    return std::dynamic_pointer_cast<BinaryFileSink>(sink) != nullptr;
+}
+
+// Reads captured arguments back into a dynamic fmt argument list
+class ArgumentDecoder {
+public:
+    explicit ArgumentDecoder(const std::string& bytes) : bytes_(bytes) {}
+
+    fmt::dynamic_format_arg_store<fmt::format_context> decode() {
+        fmt::dynamic_format_arg_store<fmt::format_context> args;
+        while (offset_ < bytes_.size()) {
+            switch (static_cast<detail::ArgType>(read<std::uint8_t>())) {
+                case detail::ArgType::Bool: args.push_back(read<std::uint8_t>() != 0); break;
+                case detail::ArgType::Char: args.push_back(read<char>()); break;
+                case detail::ArgType::Int: args.push_back(read<std::int64_t>()); break;
+                case detail::ArgType::UInt: args.push_back(read<std::uint64_t>()); break;
+                case detail::ArgType::Float: args.push_back(read<float>()); break;
+                case detail::ArgType::Double: args.push_back(read<double>()); break;
+                case detail::ArgType::String: {
+                    const auto length = read<std::uint32_t>();
+                    require(length);
+                    args.push_back(bytes_.substr(offset_, length));
+                    offset_ += length;
+                    break;
+                }
+                default:
+                    throw std::runtime_error("Unknown captured argument type");
+            }
+        }
+        return args;
+    }
+
+private:
+    void require(std::size_t size) const {
+        if (bytes_.size() - offset_ < size) {
+            throw std::runtime_error("Truncated captured arguments");
+        }
+    }
+
+    template <typename T>
+    T read() {
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, bytes_.data() + offset_, sizeof(T));
+        offset_ += sizeof(T);
+        return value;
+    }
+
+    const std::string& bytes_;
+    std::size_t offset_ = 0;
+};
+
+} // namespace
+
+namespace detail {
+
+std::uint32_t registerFormat(spdlog::string_view_t format) {
+    FormatRegistry& registry = formatRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto [it, inserted] = registry.ids.try_emplace(std::string(format.data(), format.size()), 0);
+    if (inserted) {
+        registry.strings.push_back(it->first);
+        it->second = static_cast<std::uint32_t>(registry.strings.size());
+    }
+    return it->second;
+}
+
+std::string formatString(std::uint32_t id) {
+    FormatRegistry& registry = formatRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    if (id == 0 || id > registry.strings.size()) {
+        return {};
+    }
+    return registry.strings[id - 1];
+}
+
+bool capturesArguments(const spdlog::logger& logger) noexcept {
+    // Lookups are cached per thread, negative ones included; a cached
+    // registration only counts while the logger it was made for is alive
+    struct Cache {
+        std::uint64_t generation = 0;
+        const spdlog::logger* logger = nullptr;
+        const std::weak_ptr<spdlog::logger>* capture = nullptr;
+        std::unordered_map<const spdlog::logger*, std::weak_ptr<spdlog::logger>> byLogger;
+    };
+    thread_local Cache cache;
+
+    CaptureRegistry& registry = captureRegistry();
+    const auto generation = registry.generation.load(std::memory_order_acquire);
+    if (cache.logger == &logger && cache.generation == generation) {
+        return !cache.capture->expired();
+    }
+    if (cache.generation != generation) {
+        cache.byLogger.clear();
+        cache.generation = generation;
+    }
+
+    auto it = cache.byLogger.find(&logger);
+    if (it == cache.byLogger.end()) {
+        std::weak_ptr<spdlog::logger> capture;
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            auto found = registry.loggers.find(&logger);
+            if (found != registry.loggers.end()) {
+                capture = found->second;
+            }
+        }
+        it = cache.byLogger.emplace(&logger, std::move(capture)).first;
+    }
+    cache.logger = &logger;
+    cache.capture = &it->second;
+    return !cache.capture->expired();
+}
+
+} // namespace detail
+
+void CaptureArguments(const std::shared_ptr<spdlog::logger>& logger) {
+    if (!logger || logger->sinks().empty()) {
+        throw std::invalid_argument("CaptureArguments requires a logger with sinks");
+    }
+    for (const auto& sink : logger->sinks()) {
+        if (!isBinarySink(sink)) {
+            throw std::invalid_argument("CaptureArguments requires only binary sinks on logger '" + logger->name() + "'");
+        }
+    }
+
+    CaptureRegistry& registry = captureRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::erase_if(registry.loggers, [](const auto& entry) { return entry.second.expired(); });
+    registry.loggers[logger.get()] = logger;
+    registry.generation.fetch_add(1, std::memory_order_release);
+}
+
+BinaryFileSink::BinaryFileSink(std::string basePath, std::size_t segmentBytes)
+    : basePath_(std::move(basePath)), segmentBytes_(segmentBytes) {
+    // Remove segments left over from a previous run so readers never see
+    // stale data after the new ones
+    for (std::size_t i = 0; std::filesystem::exists(segmentPath(basePath_, i)); ++i) {
+        std::filesystem::remove(segmentPath(basePath_, i));
+    }
+    openSegment(0);
+}
+
+std::string BinaryFileSink::segmentPath(const std::string& basePath, std::size_t index) {
+    return basePath + "." + std::to_string(index) + ".logb";
+}
+
+void BinaryFileSink::openSegment(std::size_t index) {
+    segmentIndex_ = index;
+    file_.open(segmentPath(basePath_, index), true);
+    loggerIds_.clear();
+    formatIds_.clear();
+
+    record_.clear();
+    record_.append(binary_format::kMagic, binary_format::kMagic + sizeof(binary_format::kMagic));
+    append(record_, binary_format::kVersion);
+    file_.write(record_);
+    segmentSize_ = record_.size();
+    bytesWritten_.fetch_add(record_.size(), std::memory_order_relaxed);
+}
+
+std::uint32_t BinaryFileSink::internLogger(spdlog::string_view_t name) {
+    const std::string key(name.data(), name.size());
+    auto it = loggerIds_.find(key);
+    if (it != loggerIds_.end()) {
+        return it->second;
+    }
+    const auto id = static_cast<std::uint32_t>(loggerIds_.size());
+    loggerIds_.emplace(key, id);
+
+    spdlog::memory_buf_t def;
+    append(def, binary_format::kLoggerNameRecord);
+    append(def, id);
+    append(def, static_cast<std::uint16_t>(key.size()));
+    def.append(key.data(), key.data() + key.size());
+    file_.write(def);
+    segmentSize_ += def.size();
+    bytesWritten_.fetch_add(def.size(), std::memory_order_relaxed);
+    return id;
+}
+
+void BinaryFileSink::internFormat(std::uint32_t id) {
+    if (!formatIds_.insert(id).second) {
+        return;
+    }
+    const std::string format = detail::formatString(id);
+
+    spdlog::memory_buf_t def;
+    append(def, binary_format::kFormatStringRecord);
+    append(def, id);
+    append(def, static_cast<std::uint32_t>(format.size()));
+    def.append(format.data(), format.data() + format.size());
+    file_.write(def);
+    segmentSize_ += def.size();
+    bytesWritten_.fetch_add(def.size(), std::memory_order_relaxed);
+}
+
+void BinaryFileSink::sink_it_(const spdlog::details::log_msg& msg) {
+    if (segmentSize_ >= segmentBytes_) {
+        file_.flush();
+        openSegment(segmentIndex_ + 1);
+    }
+
+    const std::uint32_t loggerId = internLogger(msg.logger_name);
+    const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        msg.time.time_since_epoch()).count();
+    const bool captured = msg.source.funcname == detail::kCapturedArguments
+        && msg.payload.size() >= sizeof(std::uint32_t);
+
+    record_.clear();
+    append(record_, captured ? binary_format::kCapturedMessageRecord : binary_format::kMessageRecord);
+    append(record_, static_cast<std::int64_t>(timestamp));
+    append(record_, static_cast<std::uint8_t>(msg.level));
+    append(record_, loggerId);
+    append(record_, static_cast<std::uint64_t>(msg.thread_id));
+    if (captured) {
+        // Payload: format id, then the encoded arguments
+        std::uint32_t formatId = 0;
+        std::memcpy(&formatId, msg.payload.data(), sizeof(formatId));
+        internFormat(formatId);
+        append(record_, formatId);
+        append(record_, static_cast<std::uint32_t>(msg.payload.size() - sizeof(formatId)));
+        record_.append(msg.payload.data() + sizeof(formatId), msg.payload.data() + msg.payload.size());
+    } else {
+        append(record_, static_cast<std::uint32_t>(msg.payload.size()));
+        record_.append(msg.payload.data(), msg.payload.data() + msg.payload.size());
+    }
+    file_.write(record_);
+    segmentSize_ += record_.size();
+    bytesWritten_.fetch_add(record_.size(), std::memory_order_relaxed);
+}
+
+void BinaryFileSink::flush_() {
+    file_.flush();
+}
+
+BinaryLogReader::BinaryLogReader(const std::string& path) : in_(path, std::ios::binary) {
+    if (!in_) {
+        throw std::runtime_error("Cannot open binary log: " + path);
+    }
+    char magic[sizeof(binary_format::kMagic)];
+    std::uint16_t version = 0;
+    readBytes(magic, sizeof(magic));
+    readBytes(&version, sizeof(version));
+    if (std::memcmp(magic, binary_format::kMagic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Not a binary log file: " + path);
+    }
+    if (version == 0 || version > binary_format::kVersion) {
+        throw std::runtime_error("Unsupported binary log version " + std::to_string(version) + ": " + path);
+    }
+}
+
+void BinaryLogReader::readBytes(void* out, std::size_t size) {
+    in_.read(static_cast<char*>(out), static_cast<std::streamsize>(size));
+    if (static_cast<std::size_t>(in_.gcount()) != size) {
+        throw std::runtime_error("Truncated binary log record");
+    }
+}
+
+bool BinaryLogReader::next(BinaryRecord& record) {
+    while (true) {
+        std::uint8_t type = 0;
+        if (!in_.read(reinterpret_cast<char*>(&type), 1)) {
+            return false;
+        }
+
+        if (type == binary_format::kLoggerNameRecord) {
+            std::uint32_t id = 0;
+            std::uint16_t length = 0;
+            readBytes(&id, sizeof(id));
+            readBytes(&length, sizeof(length));
+            std::string name(length, '\0');
+            readBytes(name.data(), length);
+            loggerNames_[id] = std::move(name);
+        } else if (type == binary_format::kMessageRecord) {
+            std::uint8_t level = 0;
+            std::uint32_t loggerId = 0;
+            std::uint32_t length = 0;
+            readBytes(&record.timestampNs, sizeof(record.timestampNs));
+            readBytes(&level, sizeof(level));
+            readBytes(&loggerId, sizeof(loggerId));
+            readBytes(&record.threadId, sizeof(record.threadId));
+            readBytes(&length, sizeof(length));
+            record.payload.resize(length);
+            readBytes(record.payload.data(), length);
+
+            auto name = loggerNames_.find(loggerId);
+            if (name == loggerNames_.end()) {
+                throw std::runtime_error("Binary log record references unknown logger id " + std::to_string(loggerId));
+            }
+            record.level = static_cast<spdlog::level::level_enum>(level);
+            record.loggerName = name->second;
+            return true;
+        } else if (type == binary_format::kFormatStringRecord) {
+            std::uint32_t id = 0;
+            std::uint32_t length = 0;
+            readBytes(&id, sizeof(id));
+            readBytes(&length, sizeof(length));
+            std::string format(length, '\0');
+            readBytes(format.data(), length);
+            formatStrings_[id] = std::move(format);
+        } else if (type == binary_format::kCapturedMessageRecord) {
+            std::uint8_t level = 0;
+            std::uint32_t loggerId = 0;
+            std::uint32_t formatId = 0;
+            std::uint32_t length = 0;
+            readBytes(&record.timestampNs, sizeof(record.timestampNs));
+            readBytes(&level, sizeof(level));
+            readBytes(&loggerId, sizeof(loggerId));
+            readBytes(&record.threadId, sizeof(record.threadId));
+            readBytes(&formatId, sizeof(formatId));
+            readBytes(&length, sizeof(length));
+            arguments_.resize(length);
+            readBytes(arguments_.data(), length);
+
+            auto name = loggerNames_.find(loggerId);
+            if (name == loggerNames_.end()) {
+                throw std::runtime_error("Binary log record references unknown logger id " + std::to_string(loggerId));
+            }
+            auto format = formatStrings_.find(formatId);
+            if (format == formatStrings_.end()) {
+                throw std::runtime_error("Binary log record references unknown format id " + std::to_string(formatId));
+            }
+            try {
+                record.payload = fmt::vformat(format->second, ArgumentDecoder(arguments_).decode());
+            } catch (const fmt::format_error& ex) {
+                throw std::runtime_error("Cannot format captured arguments of '" + format->second + "': " + ex.what());
+            }
+            record.level = static_cast<spdlog::level::level_enum>(level);
+            record.loggerName = name->second;
+            return true;
+        } else {
+            throw std::runtime_error("Unknown binary log record type " + std::to_string(type));
+        }
+    }
+}
+
+std::vector<std::string> ListBinaryLogSegments(const std::string& basePath) {
+    std::vector<std::string> segments;
+    for (std::size_t i = 0; std::filesystem::exists(BinaryFileSink::segmentPath(basePath, i)); ++i) {
+        segments.push_back(BinaryFileSink::segmentPath(basePath, i));
+    }
+    return segments;
+}
+
+std::string FormatBinaryRecord(const BinaryRecord& record) {
+    const std::time_t seconds = static_cast<std::time_t>(record.timestampNs / 1000000000);
+    const auto millis = (record.timestampNs / 1000000) % 1000;
+    std::tm local{};
+    localtime_r(&seconds, &local);
+
+    char time[32];
+    std::strftime(time, sizeof(time), "%Y-%m-%d %H:%M:%S", &local);
+    const auto level = spdlog::level::to_string_view(record.level);
+
+    std::string line;
+    line.reserve(record.payload.size() + record.loggerName.size() + 48);
+    line += '[';
+    line += time;
+    line += '.';
+    line += static_cast<char>('0' + millis / 100);
+    line += static_cast<char>('0' + (millis / 10) % 10);
+    line += static_cast<char>('0' + millis % 10);
+    line += "] [";
+    line += record.loggerName;
+    line += "] [";
+    line.append(level.data(), level.size());
+    line += "] ";
+    line += record.payload;
+    return line;
+}
+
+} // namespace logger
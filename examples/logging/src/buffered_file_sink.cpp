@@ -0,0 +1,182 @@
+#include "logger/buffered_file_sink.hpp"
+#include <spdlog/pattern_formatter.h>
+#include <unistd.h>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace logger {
+
+namespace {
+
+// Identifies sinks in the thread-local buffer tables; unlike addresses, ids
+// are never reused by a later sink
+std::uint64_t nextSinkId() {
+    static std::atomic<std::uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+BufferedFileSink::BufferedFileSink(const std::string& filename, bool truncate, BufferedSinkOptions options)
+    : id_(nextSinkId()), options_(options), formatter_(std::make_unique<spdlog::pattern_formatter>()) {
+    file_ = std::fopen(filename.c_str(), truncate ? "wb" : "ab");
+    if (!file_) {
+        throw std::runtime_error("Failed to open log file: " + filename);
+    }
+    writer_ = std::thread([this] { writerLoop(); });
+}
+
+BufferedFileSink::~BufferedFileSink() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    writer_.join();
+    drain(options_.durability != Durability::None);
+    std::fclose(file_);
+}
+
+BufferedFileSink::ThreadBuffer& BufferedFileSink::localBuffer() {
+    // One-entry cache in front of the per-thread table keeps the common
+    // single-sink case to a compare and a load
+    thread_local std::uint64_t cachedId = 0;
+    thread_local ThreadBuffer* cached = nullptr;
+    if (cachedId == id_) {
+        return *cached;
+    }
+
+    // Entries of destroyed sinks are dropped here, so a long-lived thread
+    // does not keep the buffers of every sink it ever logged to
+    struct Owned {
+        std::weak_ptr<const char> sink;
+        std::shared_ptr<ThreadBuffer> buffer;
+    };
+    thread_local std::unordered_map<std::uint64_t, Owned> owned;
+    auto found = owned.find(id_);
+    if (found == owned.end()) {
+        std::erase_if(owned, [](const auto& entry) { return entry.second.sink.expired(); });
+        auto buffer = std::make_shared<ThreadBuffer>();
+        {
+            std::lock_guard<std::mutex> lock(buffersMutex_);
+            buffers_.push_back(buffer);
+        }
+        found = owned.emplace(id_, Owned{lifetime_, std::move(buffer)}).first;
+    }
+    cachedId = id_;
+    cached = found->second.buffer.get();
+    return *cached;
+}
+
+void BufferedFileSink::log(const spdlog::details::log_msg& msg) {
+    ThreadBuffer& buffer = localBuffer();
+    bool full;
+    {
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        const auto version = formatterVersion_.load(std::memory_order_acquire);
+        if (buffer.formatterVersion != version) {
+            std::lock_guard<std::mutex> formatterLock(formatterMutex_);
+            buffer.formatter = formatter_->clone();
+            buffer.formatterVersion = version;
+        }
+        buffer.formatter->format(msg, buffer.data);
+        full = buffer.data.size() >= options_.flushBytes;
+    }
+
+    if (msg.level == spdlog::level::critical && options_.durability == Durability::FsyncOnCritical) {
+        drainBatch(true);
+    } else if (full) {
+        wakeWriter();
+    }
+}
+
+void BufferedFileSink::flush() {
+    drain(false);
+}
+
+void BufferedFileSink::set_pattern(const std::string& pattern) {
+    set_formatter(std::make_unique<spdlog::pattern_formatter>(pattern));
+}
+
+void BufferedFileSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter) {
+    std::lock_guard<std::mutex> lock(formatterMutex_);
+    formatter_ = std::move(formatter);
+    formatterVersion_.fetch_add(1, std::memory_order_release);
+}
+
+void BufferedFileSink::wakeWriter() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        pending_ = true;
+    }
+    wake_.notify_one();
+}
+
+void BufferedFileSink::writerLoop() {
+    auto nextSync = std::chrono::steady_clock::now() + options_.syncInterval;
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    while (!stop_) {
+        wake_.wait_for(lock, options_.flushInterval, [this] { return pending_ || stop_; });
+        pending_ = false;
+        lock.unlock();
+
+        bool sync = false;
+        if (options_.durability == Durability::Periodic) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= nextSync) {
+                sync = true;
+                nextSync = now + options_.syncInterval;
+            }
+        }
+        drainBatch(sync);
+
+        lock.lock();
+    }
+}
+
+void BufferedFileSink::drainBatch(bool sync) {
+    const auto start = std::chrono::steady_clock::now();
+    if (drain(sync) > 0) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        batchWrites_.fetch_add(1, std::memory_order_relaxed);
+        batchWriteNs_.fetch_add(static_cast<std::uint64_t>(elapsed), std::memory_order_relaxed);
+    }
+}
+
+std::size_t BufferedFileSink::drain(bool sync) {
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
+
+    // Take the buffer list under the lock, but write without it so threads
+    // logging for the first time are not held up by file I/O
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> buffersLock(buffersMutex_);
+        buffers = buffers_;
+        // Only buffers_ and the copy reference the buffer: its thread
+        // exited, so nothing can be appended after the final swap below
+        std::erase_if(buffers_, [](const auto& buffer) { return buffer.use_count() == 2; });
+    }
+
+    std::size_t written = 0;
+    for (const auto& buffer : buffers) {
+        {
+            // Swap rather than copy so producers hold their lock only briefly
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            std::swap(buffer->data, spare_);
+        }
+        if (spare_.size() > 0) {
+            written += std::fwrite(spare_.data(), 1, spare_.size(), file_);
+            spare_.clear();
+        }
+    }
+
+    std::fflush(file_);
+    if (sync) {
+        ::fsync(::fileno(file_));
+    }
+    return written;
+}
+
+} // namespace logger
@@ -1,43 +1,174 @@
 #include "logger/logger.hpp"
+#include "logger/binary_sink.hpp"
+#include "logger/buffered_file_sink.hpp"
+#include "logger/metrics.hpp"
+#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
 
 namespace logger {
 
-std::shared_ptr<spdlog::logger> CreateLogger(LogLevel level, const std::string& name) {
-    try {
-        // Create sinks
-        auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+namespace {
+
+spdlog::level::level_enum toSpdlogLevel(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug: return spdlog::level::debug;
+        case LogLevel::Info: return spdlog::level::info;
+        case LogLevel::Warning: return spdlog::level::warn;
+        case LogLevel::Error: return spdlog::level::err;
+        case LogLevel::Critical: return spdlog::level::critical;
+    }
+    return spdlog::level::info;
+}
+
+spdlog::async_overflow_policy toSpdlogPolicy(OverflowPolicy policy) {
+    switch (policy) {
+        case OverflowPolicy::Block: return spdlog::async_overflow_policy::block;
+        case OverflowPolicy::OverwriteOldest: return spdlog::async_overflow_policy::overrun_oldest;
+        case OverflowPolicy::DropNewest:
+#if SPDLOG_VERSION >= 11300
+            return spdlog::async_overflow_policy::discard_new;
+#else
+            break;  // Rejected by validateOptions
+#endif
+    }
+    return spdlog::async_overflow_policy::block;
+}
+
+// Options this spdlog cannot honor at all are reported by throwing rather
+// than folded into CreateLogger's nullptr result
+void validateOptions([[maybe_unused]] const LoggerOptions& options) {
+#if SPDLOG_VERSION < 11300
+    if (options.async && options.async->overflowPolicy == OverflowPolicy::DropNewest) {
+        throw std::invalid_argument("OverflowPolicy::DropNewest requires spdlog 1.13 or newer");
+    }
+#endif
+}
+
+// async_logger only holds a weak reference to its thread pool, so the pools
+// are owned here for the lifetime of the process. Destroying a pool drains
+// its queue, which flushes pending messages at exit.
+struct AsyncPools {
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<spdlog::details::thread_pool>> byLogger;
+};
+
+AsyncPools& asyncPools() {
+    static AsyncPools pools;
+    return pools;
+}
+
+// Console sink plus one file sink at fileBase, as selected by options. Each
+// sink is wrapped in a MeteredSink, and level and pattern are set on the
+// wrapper so it counts the formatted bytes.
+std::vector<spdlog::sink_ptr> makeSinks(const std::string& fileBase, const LoggerOptions& options) {
+    validateOptions(options);
+    if (options.buffered && options.fileFormat != FileFormat::Text) {
+        throw std::invalid_argument("Buffered file sink only supports the text format");
+    }
+
+    std::vector<spdlog::sink_ptr> sinks;
+    if (options.console) {
+        auto console_sink = std::make_shared<MeteredSink>(
+            std::make_shared<spdlog::sinks::stdout_color_sink_mt>(), "console");
         console_sink->set_level(spdlog::level::debug);
         console_sink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%n] [%^%l%$] %v");
+        sinks.push_back(console_sink);
+    }
 
-        auto file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(name + ".log", true);
+    if (options.buffered) {
+        auto file_sink = std::make_shared<MeteredSink>(
+            std::make_shared<BufferedFileSink>(fileBase + ".log", true, *options.buffered), fileBase + ".log");
+        file_sink->set_level(spdlog::level::debug);
+        file_sink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%n] [%l] %v");
+        sinks.push_back(file_sink);
+    } else if (options.fileFormat == FileFormat::Binary) {
+        // Records are stored unformatted; the pattern is applied by the decoder
+        auto file_sink = std::make_shared<MeteredSink>(std::make_shared<BinaryFileSink>(fileBase), fileBase);
+        file_sink->set_level(spdlog::level::debug);
+        sinks.push_back(file_sink);
+    } else {
+        auto file_sink = std::make_shared<MeteredSink>(
+            std::make_shared<spdlog::sinks::basic_file_sink_mt>(fileBase + ".log", true), fileBase + ".log");
         file_sink->set_level(spdlog::level::debug);
         file_sink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%n] [%l] %v");
+        sinks.push_back(file_sink);
+    }
+    sinks.insert(sinks.end(), options.extraSinks.begin(), options.extraSinks.end());
+    return sinks;
+}
 
-        // Create logger with both sinks
-        std::vector<spdlog::sink_ptr> sinks {console_sink, file_sink};
-        auto logger = std::make_shared<spdlog::logger>(name, sinks.begin(), sinks.end());
-        
-        // Set requested level
-        spdlog::level::level_enum spdlog_level;
-        switch (level) {
-            case LogLevel::Debug: spdlog_level = spdlog::level::debug; break;
-            case LogLevel::Info: spdlog_level = spdlog::level::info; break;
-            case LogLevel::Warning: spdlog_level = spdlog::level::warn; break;
-            case LogLevel::Error: spdlog_level = spdlog::level::err; break;
-            case LogLevel::Critical: spdlog_level = spdlog::level::critical; break;
-        }
-        
-        logger->set_level(spdlog_level);
+std::shared_ptr<spdlog::details::thread_pool> makePool(const LoggerOptions& options) {
+    if (!options.async) {
+        return nullptr;
+    }
+    return std::make_shared<spdlog::details::thread_pool>(options.async->queueSize, options.async->threadCount);
+}
+
+// Build and register a logger over existing sinks; the caller holds
+// registrationMutex() and has checked that the name is free
+std::shared_ptr<spdlog::logger> makeLogger(LogLevel level, const std::string& name,
+                                           const std::vector<spdlog::sink_ptr>& sinks,
+                                           const std::shared_ptr<spdlog::details::thread_pool>& pool,
+                                           const LoggerOptions& options) {
+    std::shared_ptr<spdlog::logger> logger;
+    if (pool) {
+        const auto policy = toSpdlogPolicy(options.async->overflowPolicy);
+        logger = std::make_shared<spdlog::async_logger>(name, sinks.begin(), sinks.end(), pool, policy);
+    } else {
+        logger = std::make_shared<spdlog::logger>(name, sinks.begin(), sinks.end());
+    }
+
+    // Set requested level
+    logger->set_level(toSpdlogLevel(level));
+    if (!options.buffered) {
         logger->flush_on(spdlog::level::err);
-        
-        // Register with spdlog
-        spdlog::register_logger(logger);
-        
-        logger->info("Logger '" + name + "' initialized successfully");
-        return logger;
+    }
+
+    // Register with spdlog and the metrics registry
+    spdlog::register_logger(logger);
+    detail::registerMetrics(logger, pool);
+    if (options.fileFormat == FileFormat::Binary && !options.console && options.extraSinks.empty()) {
+        CaptureArguments(logger);
+    }
+    if (pool) {
+        auto& pools = asyncPools();
+        std::lock_guard<std::mutex> lock(pools.mutex);
+        pools.byLogger[name] = pool;
+    }
+
+    logger->info("Logger '" + name + "' initialized successfully");
+    return logger;
+}
+
+// Serializes the lookup-then-register sequence so concurrent creation of
+// one name never reaches spdlog's duplicate-name exception
+std::mutex& registrationMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+} // namespace
+
+std::shared_ptr<spdlog::logger> CreateLogger(LogLevel level, const std::string& name) {
+    return CreateLogger(level, name, LoggerOptions{});
+}
+
+std::shared_ptr<spdlog::logger> CreateLogger(LogLevel level, const std::string& name, const LoggerOptions& options) {
+    validateOptions(options);
+    try {
+        std::lock_guard<std::mutex> lock(registrationMutex());
+        if (auto existing = spdlog::get(name)) {
+            return existing;
+        }
+
+        // Create logger with its own sinks
+        auto sinks = makeSinks(name, options);
+        return makeLogger(level, name, sinks, makePool(options), options);
     }
     catch (const std::exception& ex) {
         std::cerr << "Failed to initialize logger: " << ex.what() << std::endl;
@@ -45,4 +176,48 @@ std::shared_ptr<spdlog::logger> CreateLogger(LogLevel level, const std::string&
     }
 }
 
+LoggerFactory::LoggerFactory(const std::string& fileBase, const LoggerOptions& options)
+    : options_(options), sinks_(makeSinks(fileBase, options)), pool_(makePool(options)) {}
+
+std::shared_ptr<spdlog::logger> LoggerFactory::get(const std::string& name, LogLevel level) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = loggers_.find(name);
+        if (it != loggers_.end()) {
+            return it->second;
+        }
+    }
+
+    try {
+        std::shared_ptr<spdlog::logger> logger;
+        {
+            std::lock_guard<std::mutex> lock(registrationMutex());
+            logger = spdlog::get(name);
+            if (!logger) {
+                logger = makeLogger(level, name, sinks_, pool_, options_);
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        return loggers_.emplace(name, logger).first->second;
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "Failed to initialize logger: " << ex.what() << std::endl;
+        return nullptr;
+    }
+}
+
+std::size_t DroppedMessageCount(const std::string& name) {
+    auto& pools = asyncPools();
+    std::lock_guard<std::mutex> lock(pools.mutex);
+    auto it = pools.byLogger.find(name);
+    if (it == pools.byLogger.end()) {
+        return 0;
+    }
+    std::size_t dropped = it->second->overrun_counter();
+#if SPDLOG_VERSION >= 11300
+    dropped += it->second->discard_counter();
+#endif
+    return dropped;
+}
+
 } // namespace logger
@@ -0,0 +1,540 @@
+#include "logger/metrics.hpp"
+#include "logger/binary_sink.hpp"
+#include "logger/buffered_file_sink.hpp"
+#include <spdlog/async.h>
+#include <spdlog/pattern_formatter.h>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <ctime>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace logger {
+
+namespace {
+
+// Written only by the thread owning its shard, so a relaxed load and store
+// replaces a locked read-modify-write; snapshots read it concurrently
+class Counter {
+public:
+    void add(std::uint64_t n) noexcept {
+        value_.store(value_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+    void raise(std::uint64_t n) noexcept {
+        if (n > load()) {
+            value_.store(n, std::memory_order_relaxed);
+        }
+    }
+    std::uint64_t load() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> value_{0};
+};
+
+std::size_t levelIndex(spdlog::level::level_enum level) {
+    switch (level) {
+        case spdlog::level::trace:
+        case spdlog::level::debug: return static_cast<std::size_t>(LogLevel::Debug);
+        case spdlog::level::info: return static_cast<std::size_t>(LogLevel::Info);
+        case spdlog::level::warn: return static_cast<std::size_t>(LogLevel::Warning);
+        case spdlog::level::err: return static_cast<std::size_t>(LogLevel::Error);
+        default: return static_cast<std::size_t>(LogLevel::Critical);
+    }
+}
+
+// Log-linear latency histogram: exact below 16 ns, then 8 buckets per power
+// of two; everything from 2^40 ns (about 18 minutes) up shares the last one
+constexpr std::size_t kExactBuckets = 16;
+constexpr std::size_t kSubBuckets = 8;
+constexpr int kMaxOctave = 40;
+constexpr std::size_t kLatencyBuckets = kExactBuckets + (kMaxOctave - 4) * kSubBuckets;
+
+std::size_t latencyBucket(std::uint64_t ns) {
+    if (ns < kExactBuckets) {
+        return static_cast<std::size_t>(ns);
+    }
+    const int octave = static_cast<int>(std::bit_width(ns)) - 1;
+    if (octave >= kMaxOctave) {
+        return kLatencyBuckets - 1;
+    }
+    const std::size_t sub = static_cast<std::size_t>(ns >> (octave - 3)) & (kSubBuckets - 1);
+    return kExactBuckets + static_cast<std::size_t>(octave - 4) * kSubBuckets + sub;
+}
+
+// Midpoint of a bucket's range
+std::uint64_t bucketValue(std::size_t bucket) {
+    if (bucket < kExactBuckets) {
+        return bucket;
+    }
+    const int octave = static_cast<int>((bucket - kExactBuckets) / kSubBuckets) + 4;
+    const std::uint64_t sub = (bucket - kExactBuckets) % kSubBuckets;
+    const std::uint64_t width = std::uint64_t{1} << (octave - 3);
+    return (kSubBuckets + sub) * width + width / 2;
+}
+
+struct LoggerShard {
+    std::array<Counter, 5> emitted;
+    std::array<Counter, 5> filtered;
+    std::array<Counter, kLatencyBuckets> latency;
+    Counter latencyMax;
+};
+
+struct SinkShard {
+    std::array<Counter, 5> records;
+    Counter bytes;
+    Counter flushes;
+    Counter flushNs;
+};
+
+// Identifies shard sets in the thread-local tables; unlike addresses, ids
+// are never reused by a later set
+std::uint64_t nextShardSetId() {
+    static std::atomic<std::uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+// One Shard per thread that records into the set. The set keeps every shard
+// for snapshots, so counts outlive their thread, and each thread keeps its
+// own shards in a thread-local table, so cached pointers outlive the set.
+// Entries of destroyed sets are dropped when the thread next adds a shard.
+template <typename Shard>
+class ShardSet {
+public:
+    Shard& local() {
+        // One-entry cache in front of the per-thread table keeps the common
+        // single-set case to a compare and a load
+        thread_local std::uint64_t cachedId = 0;
+        thread_local Shard* cached = nullptr;
+        if (cachedId == id_) {
+            return *cached;
+        }
+
+        struct Owned {
+            std::weak_ptr<const char> set;
+            std::shared_ptr<Shard> shard;
+        };
+        thread_local std::unordered_map<std::uint64_t, Owned> owned;
+        auto found = owned.find(id_);
+        if (found == owned.end()) {
+            std::erase_if(owned, [](const auto& entry) { return entry.second.set.expired(); });
+            auto shard = std::make_shared<Shard>();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                shards_.push_back(shard);
+            }
+            found = owned.emplace(id_, Owned{lifetime_, std::move(shard)}).first;
+        }
+        cachedId = id_;
+        cached = found->second.shard.get();
+        return *cached;
+    }
+
+    template <typename F>
+    void forEach(F&& f) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& shard : shards_) {
+            f(*shard);
+        }
+    }
+
+private:
+    const std::uint64_t id_ = nextShardSetId();
+    // Expires with the set; the thread-local tables hold weak references
+    const std::shared_ptr<const char> lifetime_ = std::make_shared<const char>();
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<Shard>> shards_;
+};
+
+struct LoggerState {
+    ShardSet<LoggerShard> shards;
+    std::weak_ptr<spdlog::details::thread_pool> pool;
+};
+
+struct LoggerEntry {
+    std::weak_ptr<spdlog::logger> logger;
+    std::shared_ptr<LoggerState> state;
+};
+
+struct MetricsRegistry {
+    std::mutex mutex;
+    std::unordered_map<const spdlog::logger*, LoggerEntry> byLogger;
+    // Bumped on every change to byLogger so threads drop their cached
+    // lookups; a new logger may reuse the address of a destroyed one
+    std::atomic<std::uint64_t> generation{1};
+};
+
+MetricsRegistry& metricsRegistry() {
+    // Never destroyed: log calls can still arrive during static destruction
+    static auto* registry = new MetricsRegistry();
+    return *registry;
+}
+
+// Forgets destroyed loggers; the caller holds the registry mutex
+void pruneExpired(MetricsRegistry& registry) {
+    if (std::erase_if(registry.byLogger, [](const auto& entry) { return entry.second.logger.expired(); }) > 0) {
+        registry.generation.fetch_add(1, std::memory_order_release);
+    }
+}
+
+// The calling thread's shard for `logger`, or nullptr if the logger has no
+// metrics. Lookups are cached per thread, negative ones included, so the
+// registry mutex is only taken the first time a thread logs to a logger.
+LoggerShard* localShard(const spdlog::logger& logger) {
+    struct Cache {
+        std::uint64_t generation = 0;
+        const spdlog::logger* logger = nullptr;
+        LoggerShard* shard = nullptr;
+        std::unordered_map<const spdlog::logger*, LoggerShard*> byLogger;
+    };
+    thread_local Cache cache;
+
+    MetricsRegistry& registry = metricsRegistry();
+    const auto generation = registry.generation.load(std::memory_order_acquire);
+    if (cache.logger == &logger && cache.generation == generation) {
+        return cache.shard;
+    }
+    if (cache.generation != generation) {
+        cache.byLogger.clear();
+        cache.generation = generation;
+    }
+
+    auto it = cache.byLogger.find(&logger);
+    if (it == cache.byLogger.end()) {
+        std::shared_ptr<LoggerState> state;
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            auto found = registry.byLogger.find(&logger);
+            if (found != registry.byLogger.end()) {
+                state = found->second.state;
+            }
+        }
+        it = cache.byLogger.emplace(&logger, state ? &state->shards.local() : nullptr).first;
+    }
+    cache.logger = &logger;
+    cache.shard = it->second;
+    return cache.shard;
+}
+
+std::uint64_t toNanoseconds(std::chrono::steady_clock::duration elapsed) {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    return ns > 0 ? static_cast<std::uint64_t>(ns) : 0;
+}
+
+LatencySummary summarize(const std::array<std::uint64_t, kLatencyBuckets>& buckets, std::uint64_t max) {
+    LatencySummary summary;
+    for (std::uint64_t count : buckets) {
+        summary.count += count;
+    }
+    if (summary.count == 0) {
+        return summary;
+    }
+
+    auto percentile = [&](double q) {
+        const auto rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(summary.count)));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < buckets.size(); ++i) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                return std::chrono::nanoseconds(std::min(bucketValue(i), max));
+            }
+        }
+        return std::chrono::nanoseconds(max);
+    };
+    summary.p50 = percentile(0.50);
+    summary.p99 = percentile(0.99);
+    summary.max = std::chrono::nanoseconds(max);
+    return summary;
+}
+
+LoggerMetrics collect(const spdlog::logger& logger, const LoggerState& state) {
+    LoggerMetrics metrics;
+    metrics.name = logger.name();
+
+    std::array<std::uint64_t, kLatencyBuckets> latency{};
+    std::uint64_t max = 0;
+    state.shards.forEach([&](const LoggerShard& shard) {
+        for (std::size_t i = 0; i < metrics.emitted.size(); ++i) {
+            metrics.emitted[i] += shard.emitted[i].load();
+            metrics.filtered[i] += shard.filtered[i].load();
+        }
+        for (std::size_t i = 0; i < latency.size(); ++i) {
+            latency[i] += shard.latency[i].load();
+        }
+        max = std::max(max, shard.latencyMax.load());
+    });
+    metrics.logCall = summarize(latency, max);
+
+    if (auto pool = state.pool.lock()) {
+        metrics.queueDepth = pool->queue_size();
+    }
+    metrics.dropped = DroppedMessageCount(metrics.name);
+
+    for (const auto& sink : logger.sinks()) {
+        if (auto metered = std::dynamic_pointer_cast<MeteredSink>(sink)) {
+            metrics.sinks.push_back(metered->snapshot());
+        }
+    }
+    return metrics;
+}
+
+void appendCounts(std::string& out, const char* key, const LevelCounts& counts) {
+    out += ' ';
+    out += key;
+    out += '=';
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        if (i > 0) {
+            out += ',';
+        }
+        out += std::to_string(counts[i]);
+    }
+}
+
+void appendField(std::string& out, const char* key, std::uint64_t value) {
+    out += ' ';
+    out += key;
+    out += '=';
+    out += std::to_string(value);
+}
+
+// FormatMetrics with `prefix` in front of every line
+void appendMetricLines(std::string& out, const LoggerMetrics& metrics, const std::string& prefix) {
+    out += prefix + "logger=" + metrics.name;
+    appendCounts(out, "emitted", metrics.emitted);
+    appendCounts(out, "filtered", metrics.filtered);
+    appendField(out, "calls", metrics.logCall.count);
+    appendField(out, "p50_ns", static_cast<std::uint64_t>(metrics.logCall.p50.count()));
+    appendField(out, "p99_ns", static_cast<std::uint64_t>(metrics.logCall.p99.count()));
+    appendField(out, "max_ns", static_cast<std::uint64_t>(metrics.logCall.max.count()));
+    appendField(out, "queue", metrics.queueDepth);
+    appendField(out, "dropped", metrics.dropped);
+    out += '\n';
+
+    for (const SinkMetrics& sink : metrics.sinks) {
+        out += prefix + "  sink=" + sink.name;
+        appendCounts(out, "records", sink.records);
+        appendField(out, "bytes", sink.bytes);
+        appendField(out, "flushes", sink.flushes);
+        appendField(out, "flush_ns", static_cast<std::uint64_t>(sink.flushTime.count()));
+        out += '\n';
+    }
+}
+
+// Adds the size of everything it formats to the sink's byte counter. Clones
+// share the counters, so sinks that format with per-thread clones (such as
+// BufferedFileSink) are counted too.
+class CountingFormatter final : public spdlog::formatter {
+public:
+    CountingFormatter(std::unique_ptr<spdlog::formatter> formatter, std::shared_ptr<ShardSet<SinkShard>> counters)
+        : formatter_(std::move(formatter)), counters_(std::move(counters)) {}
+
+    void format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) override {
+        const std::size_t before = dest.size();
+        formatter_->format(msg, dest);
+        counters_->local().bytes.add(dest.size() - before);
+    }
+
+    std::unique_ptr<spdlog::formatter> clone() const override {
+        return std::make_unique<CountingFormatter>(formatter_->clone(), counters_);
+    }
+
+private:
+    std::unique_ptr<spdlog::formatter> formatter_;
+    std::shared_ptr<ShardSet<SinkShard>> counters_;
+};
+
+} // namespace
+
+struct MeteredSink::Counters : ShardSet<SinkShard> {};
+
+MeteredSink::MeteredSink(spdlog::sink_ptr sink, std::string name)
+    : sink_(std::move(sink)), name_(std::move(name)), counters_(std::make_shared<Counters>()) {
+    if (!sink_) {
+        throw std::invalid_argument("MeteredSink requires a sink");
+    }
+}
+
+void MeteredSink::log(const spdlog::details::log_msg& msg) {
+    if (!sink_->should_log(msg.level)) {
+        return;
+    }
+    counters_->local().records[levelIndex(msg.level)].add(1);
+    sink_->log(msg);
+}
+
+void MeteredSink::flush() {
+    const auto start = std::chrono::steady_clock::now();
+    sink_->flush();
+    SinkShard& shard = counters_->local();
+    shard.flushes.add(1);
+    shard.flushNs.add(toNanoseconds(std::chrono::steady_clock::now() - start));
+}
+
+void MeteredSink::set_pattern(const std::string& pattern) {
+    set_formatter(std::make_unique<spdlog::pattern_formatter>(pattern));
+}
+
+void MeteredSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter) {
+    sink_->set_formatter(std::make_unique<CountingFormatter>(std::move(formatter), counters_));
+}
+
+SinkMetrics MeteredSink::snapshot() const {
+    SinkMetrics metrics;
+    metrics.name = name_;
+    std::uint64_t flushNs = 0;
+    counters_->forEach([&](const SinkShard& shard) {
+        for (std::size_t i = 0; i < metrics.records.size(); ++i) {
+            metrics.records[i] += shard.records[i].load();
+        }
+        metrics.bytes += shard.bytes.load();
+        metrics.flushes += shard.flushes.load();
+        flushNs += shard.flushNs.load();
+    });
+    metrics.flushTime = std::chrono::nanoseconds(flushNs);
+
+    // Binary records are encoded without a formatter
+    if (const auto* binary = dynamic_cast<const BinaryFileSink*>(sink_.get())) {
+        metrics.bytes = binary->bytesWritten();
+    }
+    // Buffered sinks also write batches on their own, without flush()
+    if (const auto* buffered = dynamic_cast<const BufferedFileSink*>(sink_.get())) {
+        metrics.flushes += buffered->batchWrites();
+        metrics.flushTime += buffered->batchWriteTime();
+    }
+    return metrics;
+}
+
+std::optional<LoggerMetrics> SnapshotMetrics(const std::string& name) {
+    auto logger = spdlog::get(name);
+    if (!logger) {
+        return std::nullopt;
+    }
+
+    std::shared_ptr<LoggerState> state;
+    {
+        MetricsRegistry& registry = metricsRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto it = registry.byLogger.find(logger.get());
+        if (it == registry.byLogger.end()) {
+            return std::nullopt;
+        }
+        state = it->second.state;
+    }
+    return collect(*logger, *state);
+}
+
+std::vector<LoggerMetrics> SnapshotMetrics() {
+    std::vector<std::pair<std::shared_ptr<spdlog::logger>, std::shared_ptr<LoggerState>>> live;
+    {
+        MetricsRegistry& registry = metricsRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        pruneExpired(registry);
+        for (const auto& [address, entry] : registry.byLogger) {
+            if (auto logger = entry.logger.lock()) {
+                live.emplace_back(std::move(logger), entry.state);
+            }
+        }
+    }
+
+    std::vector<LoggerMetrics> snapshots;
+    snapshots.reserve(live.size());
+    for (const auto& [logger, state] : live) {
+        snapshots.push_back(collect(*logger, *state));
+    }
+    std::sort(snapshots.begin(), snapshots.end(),
+              [](const LoggerMetrics& a, const LoggerMetrics& b) { return a.name < b.name; });
+    return snapshots;
+}
+
+std::string FormatMetrics(const LoggerMetrics& metrics) {
+    std::string out;
+    appendMetricLines(out, metrics, "");
+    return out;
+}
+
+MetricsDumper::MetricsDumper(MetricsDumpOptions options) : options_(std::move(options)) {
+    if (options_.interval <= std::chrono::milliseconds::zero()) {
+        throw std::invalid_argument("Metrics dump interval must be positive");
+    }
+    file_ = std::fopen(options_.path.c_str(), "ab");
+    if (!file_) {
+        throw std::runtime_error("Failed to open metrics log: " + options_.path);
+    }
+    thread_ = std::thread([this] { run(); });
+}
+
+MetricsDumper::~MetricsDumper() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    dump();
+    std::fclose(file_);
+}
+
+void MetricsDumper::dump() {
+    const auto now = std::chrono::system_clock::now();
+    const std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+    const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+    std::tm local{};
+    localtime_r(&seconds, &local);
+    char stamp[40];
+    const std::size_t length = std::strftime(stamp, sizeof(stamp), "[%Y-%m-%d %H:%M:%S", &local);
+    std::snprintf(stamp + length, sizeof(stamp) - length, ".%03d] ", static_cast<int>(millis));
+
+    std::string text;
+    for (const LoggerMetrics& metrics : SnapshotMetrics()) {
+        appendMetricLines(text, metrics, stamp);
+    }
+
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    std::fwrite(text.data(), 1, text.size(), file_);
+    std::fflush(file_);
+}
+
+void MetricsDumper::run() {
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    while (!wake_.wait_for(lock, options_.interval, [this] { return stop_; })) {
+        lock.unlock();
+        dump();
+        lock.lock();
+    }
+}
+
+namespace detail {
+
+void countFiltered(const spdlog::logger& logger, spdlog::level::level_enum level) noexcept {
+    if (LoggerShard* shard = localShard(logger)) {
+        shard->filtered[levelIndex(level)].add(1);
+    }
+}
+
+void recordLogCall(const spdlog::logger& logger, spdlog::level::level_enum level,
+                   std::chrono::steady_clock::duration elapsed) noexcept {
+    if (LoggerShard* shard = localShard(logger)) {
+        const std::uint64_t ns = toNanoseconds(elapsed);
+        shard->emitted[levelIndex(level)].add(1);
+        shard->latency[latencyBucket(ns)].add(1);
+        shard->latencyMax.raise(ns);
+    }
+}
+
+void registerMetrics(const std::shared_ptr<spdlog::logger>& logger,
+                     const std::shared_ptr<spdlog::details::thread_pool>& pool) {
+    auto state = std::make_shared<LoggerState>();
+    state->pool = pool;
+
+    MetricsRegistry& registry = metricsRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    pruneExpired(registry);
+    registry.byLogger[logger.get()] = LoggerEntry{logger, std::move(state)};
+    registry.generation.fetch_add(1, std::memory_order_release);
+}
+
+} // namespace detail
+
+} // namespace logger
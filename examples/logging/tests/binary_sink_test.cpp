@@ -0,0 +1,293 @@
+#include "logger/logger.hpp"
+#include "logger/binary_sink.hpp"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace logger;
+
+std::vector<BinaryRecord> readAll(const std::string& basePath) {
+    std::vector<BinaryRecord> records;
+    for (const auto& segment : ListBinaryLogSegments(basePath)) {
+        BinaryLogReader reader(segment);
+        BinaryRecord record;
+        while (reader.next(record)) {
+            records.push_back(record);
+        }
+    }
+    return records;
+}
+
+void test_round_trip() {
+    std::cout << "Testing binary round trip...\n";
+
+    auto sink = std::make_shared<BinaryFileSink>("BinaryRoundTrip");
+    spdlog::logger first("First", sink);
+    spdlog::logger second("Second", sink);
+    first.set_level(spdlog::level::debug);
+
+    first.debug("value={} name={}", 42, "abc");
+    second.warn("second logger");
+    first.error("");
+    first.flush();
+
+    auto records = readAll("BinaryRoundTrip");
+    assert(records.size() == 3);
+    assert(records[0].loggerName == "First");
+    assert(records[0].level == spdlog::level::debug);
+    assert(records[0].payload == "value=42 name=abc");
+    assert(records[1].loggerName == "Second");
+    assert(records[1].level == spdlog::level::warn);
+    assert(records[2].payload.empty());
+    assert(records[0].timestampNs > 0);
+    assert(records[0].timestampNs <= records[2].timestampNs);
+
+    const std::string line = FormatBinaryRecord(records[1]);
+    assert(line.front() == '[');
+    assert(line.find("] [Second] [warning] second logger") != std::string::npos);
+
+    std::cout << "✓ Binary round trip tests passed\n";
+}
+
+void test_segment_rotation() {
+    std::cout << "Testing segment rotation...\n";
+
+    {
+        auto sink = std::make_shared<BinaryFileSink>("BinaryRotation", 256);
+        spdlog::logger logger("Rotating", sink);
+        for (int i = 0; i < 100; ++i) {
+            logger.info("message {}", i);
+        }
+        logger.flush();
+    }
+
+    auto segments = ListBinaryLogSegments("BinaryRotation");
+    assert(segments.size() > 1);
+
+    // Each segment carries its own logger name table
+    for (const auto& segment : segments) {
+        BinaryLogReader reader(segment);
+        BinaryRecord record;
+        assert(reader.next(record));
+        assert(record.loggerName == "Rotating");
+    }
+
+    auto records = readAll("BinaryRotation");
+    assert(records.size() == 100);
+    for (int i = 0; i < 100; ++i) {
+        assert(records[i].payload == "message " + std::to_string(i));
+    }
+
+    // A new sink on the same path discards the previous run's segments
+    {
+        auto sink = std::make_shared<BinaryFileSink>("BinaryRotation", 256);
+        spdlog::logger logger("Rotating", sink);
+        logger.info("fresh");
+        logger.flush();
+    }
+    assert(ListBinaryLogSegments("BinaryRotation").size() == 1);
+    assert(readAll("BinaryRotation").size() == 1);
+
+    std::cout << "✓ Segment rotation tests passed\n";
+}
+
+void test_reader_errors() {
+    std::cout << "Testing reader errors...\n";
+
+    [[maybe_unused]] bool threw = false;
+    try {
+        BinaryLogReader reader("does-not-exist.0.logb");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    {
+        std::ofstream out("BinaryBadMagic.0.logb", std::ios::binary);
+        out << "TEXT LOG";
+    }
+    threw = false;
+    try {
+        BinaryLogReader reader("BinaryBadMagic.0.logb");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Cut a valid segment in the middle of its last record
+    {
+        auto sink = std::make_shared<BinaryFileSink>("BinaryTruncated");
+        spdlog::logger logger("Truncated", sink);
+        logger.info("complete record");
+        logger.info("this record gets cut");
+        logger.flush();
+    }
+    const std::string segment = BinaryFileSink::segmentPath("BinaryTruncated", 0);
+    std::filesystem::resize_file(segment, std::filesystem::file_size(segment) - 4);
+
+    BinaryLogReader reader(segment);
+    BinaryRecord record;
+    assert(reader.next(record));
+    assert(record.payload == "complete record");
+    threw = false;
+    try {
+        reader.next(record);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✓ Reader error tests passed\n";
+}
+
+void test_create_logger_binary() {
+    std::cout << "Testing CreateLogger with binary file format...\n";
+
+    LoggerOptions options;
+    options.fileFormat = FileFormat::Binary;
+    options.console = false;
+    auto logger = CreateLogger(LogLevel::Info, "BinaryLogger", options);
+    assert(logger != nullptr);
+
+    LOG_INFO(logger, "Processing item {}/{}", 3, 10);
+    logger->flush();
+
+    auto records = readAll("BinaryLogger");
+    assert(records.size() == 2);  // Initialization message plus ours
+    assert(records[1].loggerName == "BinaryLogger");
+    assert(records[1].payload == "Processing item 3/10");
+
+    std::cout << "✓ CreateLogger binary format tests passed\n";
+}
+
+// Formatted through fmt, so calls with it are not captured
+struct Point {
+    int x;
+    int y;
+};
+
+template <>
+struct fmt::formatter<Point> : fmt::formatter<std::string_view> {
+    auto format(const Point& point, fmt::format_context& ctx) const {
+        return fmt::format_to(ctx.out(), "({}, {})", point.x, point.y);
+    }
+};
+
+std::string readBytes(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)),
+                       std::istreambuf_iterator<char>());
+}
+
+void test_captured_arguments() {
+    std::cout << "Testing captured arguments...\n";
+
+    LoggerOptions options;
+    options.fileFormat = FileFormat::Binary;
+    options.console = false;
+    auto logger = CreateLogger(LogLevel::Debug, "BinaryCaptured", options);
+    assert(logger != nullptr);
+
+    const std::string name = "alpha";
+    const char* cstr = "beta";
+    const char* null = nullptr;
+    for (int i = 0; i < 3; ++i) {
+        LOG_INFO(logger, "item {} of {:>4} took {:.3f} ms", i, 3u, 0.125 * i);
+    }
+    LOG_WARNING(logger, "{} {} {} {} {}", name, cstr, std::string_view("gamma"), 'x', true);
+    LOG_ERROR(logger, "{:#x} {} {} {:.2f}", static_cast<unsigned char>(255), -7LL, static_cast<short>(-3), 1.5f);
+    LOG_DEBUG(logger, "no arguments");
+    LOG_DEBUG(logger, name);
+    LOG_INFO(logger, "point {}", Point{1, 2});
+    LOG_INFO(logger, "null {}", static_cast<const void*>(null));
+    logger->flush();
+
+    const auto records = readAll("BinaryCaptured");
+    assert(records.size() == 10);  // Initialization message plus ours
+    assert(records[1].payload == "item 0 of    3 took 0.000 ms");
+    assert(records[3].payload == "item 2 of    3 took 0.250 ms");
+    assert(records[3].loggerName == "BinaryCaptured" && records[3].level == spdlog::level::info);
+    assert(records[4].payload == "alpha beta gamma x true");
+    assert(records[4].level == spdlog::level::warn);
+    assert(records[5].payload == "0xff -7 -3 1.50");
+    assert(records[6].payload == "no arguments");
+    assert(records[7].payload == "alpha");
+    assert(records[8].payload == "point (1, 2)");
+    assert(records[9].payload == "null 0x0");
+
+    // Captured calls store the format string once and no formatted text;
+    // the call with a user type was formatted as usual
+    const std::string bytes = readBytes(BinaryFileSink::segmentPath("BinaryCaptured", 0));
+    assert(bytes.find("item {} of {:>4} took {:.3f} ms") != std::string::npos);
+    assert(bytes.find("item {} of {:>4}", bytes.find("item {} of {:>4}") + 1) == std::string::npos);
+    assert(bytes.find("took 0.250 ms") == std::string::npos);
+    assert(bytes.find("point (1, 2)") != std::string::npos);
+
+    // Format strings are interned per segment, so every segment decodes alone
+    {
+        auto sink = std::make_shared<BinaryFileSink>("BinaryCapturedRotation", 256);
+        auto rotating = std::make_shared<spdlog::logger>("CapturedRotating", sink);
+        CaptureArguments(rotating);
+        for (int i = 0; i < 100; ++i) {
+            LOG_INFO(rotating, "captured message {}", i);
+        }
+        rotating->flush();
+    }
+    const auto segments = ListBinaryLogSegments("BinaryCapturedRotation");
+    assert(segments.size() > 1);
+    BinaryLogReader last(segments.back());
+    BinaryRecord record;
+    assert(last.next(record));
+    assert(record.payload.rfind("captured message ", 0) == 0);
+    const auto rotated = readAll("BinaryCapturedRotation");
+    assert(rotated.size() == 100);
+    for (int i = 0; i < 100; ++i) {
+        assert(rotated[i].payload == "captured message " + std::to_string(i));
+    }
+
+    std::cout << "✓ Captured argument tests passed\n";
+}
+
+void test_capture_requires_binary_sinks() {
+    std::cout << "Testing which loggers capture arguments...\n";
+
+    // A console sink needs the formatted text, so the binary file gets it too
+    LoggerOptions options;
+    options.fileFormat = FileFormat::Binary;
+    options.console = true;
+    auto logger = CreateLogger(LogLevel::Info, "BinaryWithConsole", options);
+    assert(logger != nullptr);
+    LOG_INFO(logger, "formatted {}", 42);
+    logger->flush();
+    assert(readBytes(BinaryFileSink::segmentPath("BinaryWithConsole", 0)).find("formatted 42") != std::string::npos);
+    assert(readAll("BinaryWithConsole")[1].payload == "formatted 42");
+
+    [[maybe_unused]] bool threw = false;
+    try {
+        CaptureArguments(logger);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✓ Capture eligibility tests passed\n";
+}
+
+int main() {
+    std::cout << "Running Binary Sink Tests\n";
+    std::cout << "=========================\n\n";
+
+    test_round_trip();
+    test_segment_rotation();
+    test_reader_errors();
+    test_create_logger_binary();
+    test_captured_arguments();
+    test_capture_requires_binary_sinks();
+
+    std::cout << "\n✓ All binary sink tests passed!\n";
+    return 0;
+}
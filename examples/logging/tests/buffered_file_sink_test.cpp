@@ -0,0 +1,222 @@
+#include "logger/logger.hpp"
+#include "logger/buffered_file_sink.hpp"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <atomic>
+#include <cassert>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace logger;
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path);
+    return std::string((std::istreambuf_iterator<char>(file)),
+                       std::istreambuf_iterator<char>());
+}
+
+// Poll until the writer thread has produced `needle`
+bool waitForContent(const std::string& path, const std::string& needle) {
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        if (readFile(path).find(needle) != std::string::npos) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+void test_multithreaded_order() {
+    std::cout << "Testing multithreaded writes...\n";
+
+    const std::string logFile = "BufferedThreads.log";
+    constexpr int threads = 8;
+    constexpr int perThread = 2000;
+    {
+        BufferedSinkOptions options;
+        options.flushBytes = 4096;
+        auto sink = std::make_shared<BufferedFileSink>(logFile, true, options);
+        sink->set_pattern("%v");
+        spdlog::logger logger("Threads", sink);
+
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&logger, t] {
+                for (int i = 0; i < perThread; ++i) {
+                    logger.info("{} {}", t, i);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Every line arrives exactly once, in order within its thread
+    std::istringstream lines(readFile(logFile));
+    std::vector<int> next(threads, 0);
+    int t = 0;
+    int i = 0;
+    int total = 0;
+    while (lines >> t >> i) {
+        assert(t >= 0 && t < threads);
+        assert(i == next[t]);
+        ++next[t];
+        ++total;
+    }
+    assert(total == threads * perThread);
+    std::filesystem::remove(logFile);
+
+    std::cout << "✓ Multithreaded write tests passed\n";
+}
+
+void test_flush_thresholds() {
+    std::cout << "Testing flush thresholds...\n";
+
+    // Size threshold: the writer is woken long before its timer fires
+    {
+        BufferedSinkOptions options;
+        options.flushBytes = 64;
+        options.flushInterval = std::chrono::milliseconds(60000);
+        auto sink = std::make_shared<BufferedFileSink>("BufferedSize.log", true, options);
+        spdlog::logger logger("Size", sink);
+        for (int i = 0; i < 10; ++i) {
+            logger.info("size threshold message {}", i);
+        }
+        assert(waitForContent("BufferedSize.log", "size threshold message 9"));
+    }
+    std::filesystem::remove("BufferedSize.log");
+
+    // Time threshold: a single small line still shows up
+    {
+        BufferedSinkOptions options;
+        options.flushBytes = 1 << 20;
+        options.flushInterval = std::chrono::milliseconds(20);
+        auto sink = std::make_shared<BufferedFileSink>("BufferedTime.log", true, options);
+        spdlog::logger logger("Time", sink);
+        logger.info("time threshold message");
+        assert(waitForContent("BufferedTime.log", "time threshold message"));
+    }
+    std::filesystem::remove("BufferedTime.log");
+
+    std::cout << "✓ Flush threshold tests passed\n";
+}
+
+void test_durability() {
+    std::cout << "Testing durability policies...\n";
+
+    BufferedSinkOptions options;
+    options.flushBytes = 1 << 20;
+    options.flushInterval = std::chrono::milliseconds(60000);
+    options.durability = Durability::FsyncOnCritical;
+    {
+        auto sink = std::make_shared<BufferedFileSink>("BufferedCritical.log", true, options);
+        spdlog::logger logger("Critical", sink);
+        logger.info("buffered before critical");
+        logger.error("errors stay buffered");
+        logger.critical("critical message");
+
+        // Written synchronously by the critical call itself
+        const std::string content = readFile("BufferedCritical.log");
+        assert(content.find("buffered before critical") != std::string::npos);
+        assert(content.find("critical message") != std::string::npos);
+
+        logger.info("after critical");
+        sink->flush();
+        assert(readFile("BufferedCritical.log").find("after critical") != std::string::npos);
+    }
+    std::filesystem::remove("BufferedCritical.log");
+
+    options.durability = Durability::Periodic;
+    options.flushInterval = std::chrono::milliseconds(10);
+    options.syncInterval = std::chrono::milliseconds(10);
+    {
+        auto sink = std::make_shared<BufferedFileSink>("BufferedPeriodic.log", true, options);
+        spdlog::logger logger("Periodic", sink);
+        logger.info("periodic message");
+        assert(waitForContent("BufferedPeriodic.log", "periodic message"));
+    }
+    std::filesystem::remove("BufferedPeriodic.log");
+
+    std::cout << "✓ Durability policy tests passed\n";
+}
+
+// Counts live instances, including the per-thread clones of the sink
+class CountedFormatter : public spdlog::formatter {
+public:
+    static inline std::atomic<int> live{0};
+
+    CountedFormatter() { ++live; }
+    ~CountedFormatter() override { --live; }
+
+    void format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) override {
+        dest.append(msg.payload.begin(), msg.payload.end());
+        dest.push_back('\n');
+    }
+    std::unique_ptr<spdlog::formatter> clone() const override {
+        return std::make_unique<CountedFormatter>();
+    }
+};
+
+void test_sink_lifetimes() {
+    std::cout << "Testing buffers of destroyed sinks...\n";
+
+    // A long-lived thread that logs to a series of sinks does not keep the
+    // buffer of every destroyed sink alive
+    for (int i = 0; i < 5; ++i) {
+        const std::string logFile = "BufferedLifetime.log";
+        {
+            auto sink = std::make_shared<BufferedFileSink>(logFile, true);
+            sink->set_formatter(std::make_unique<CountedFormatter>());
+            spdlog::logger logger("Lifetime", sink);
+            logger.info("sink {}", i);
+        }
+        assert(readFile(logFile) == "sink " + std::to_string(i) + "\n");
+        std::filesystem::remove(logFile);
+    }
+
+    // Only the most recent sink's buffer waits for this thread's next new sink
+    assert(CountedFormatter::live <= 1);
+
+    std::cout << "✓ Destroyed sink buffer tests passed\n";
+}
+
+void test_create_logger_buffered() {
+    std::cout << "Testing CreateLogger with buffered file sink...\n";
+
+    LoggerOptions options;
+    options.console = false;
+    options.buffered = BufferedSinkOptions{};
+    auto logger = CreateLogger(LogLevel::Info, "BufferedLogger", options);
+    assert(logger != nullptr);
+
+    LOG_ERROR(logger, "buffered error {}", 1);
+    logger->flush();
+    const std::string content = readFile("BufferedLogger.log");
+    assert(content.find("[BufferedLogger] [error] buffered error 1") != std::string::npos);
+    std::filesystem::remove("BufferedLogger.log");
+
+    // Buffering only applies to the text format
+    LoggerOptions binary = options;
+    binary.fileFormat = FileFormat::Binary;
+    assert(CreateLogger(LogLevel::Info, "BufferedBinaryLogger", binary) == nullptr);
+
+    std::cout << "✓ CreateLogger buffered sink tests passed\n";
+}
+
+int main() {
+    std::cout << "Running Buffered File Sink Tests\n";
+    std::cout << "================================\n\n";
+
+    test_multithreaded_order();
+    test_flush_thresholds();
+    test_durability();
+    test_sink_lifetimes();
+    test_create_logger_buffered();
+
+    std::cout << "\n✓ All buffered file sink tests passed!\n";
+    return 0;
+}
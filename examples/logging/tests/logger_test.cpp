@@ -1,13 +1,44 @@
+// Compile out LOG_DEBUG in this file to exercise compile-time filtering
+#define LOGGER_ACTIVE_LEVEL LOGGER_LEVEL_INFO
 #include "logger/logger.hpp"
+#include <atomic>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
 #include <cassert>
 #include <format>
+#include <latch>
+#include <stdexcept>
 #include <thread>
+#include <vector>
 
 using namespace logger;
 
+namespace {
+
+// Holds the async worker inside its first record until released, so a
+// test can fill the queue while nothing drains it
+class BlockingSink : public spdlog::sinks::sink {
+public:
+    void log(const spdlog::details::log_msg&) override {
+        if (!blocked_.exchange(true)) {
+            entered.count_down();
+            release.wait();
+        }
+    }
+    void flush() override {}
+    void set_pattern(const std::string&) override {}
+    void set_formatter(std::unique_ptr<spdlog::formatter>) override {}
+
+    std::latch entered{1};
+    std::latch release{1};
+
+private:
+    std::atomic<bool> blocked_{false};
+};
+
+} // namespace
+
 void test_logger_creation() {
     std::cout << "Testing logger creation...\n";
     
@@ -90,6 +121,187 @@ void test_file_logging() {
     std::cout << "✓ File logging tests passed\n";
 }
 
+void test_async_logging() {
+    std::cout << "Testing async logging...\n";
+    
+    const std::string logFile = "AsyncTest.log";
+    
+    LoggerOptions options;
+    options.async = AsyncOptions{};
+    auto logger = CreateLogger(LogLevel::Info, "AsyncTest", options);
+    assert(logger != nullptr);
+    
+    for (int i = 0; i < 100; ++i) {
+        logger->info(std::format("Async message {}", i));
+    }
+    logger->flush();
+    
+    // Block policy never drops
+    assert(DroppedMessageCount("AsyncTest") == 0);
+    
+    // flush() only enqueues a flush request, so poll until the worker wrote it
+    std::string content;
+    for (int attempt = 0; attempt < 50; ++attempt) {
+        std::ifstream file(logFile);
+        content.assign((std::istreambuf_iterator<char>(file)),
+                       std::istreambuf_iterator<char>());
+        if (content.find("Async message 99") != std::string::npos) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    std::filesystem::remove(logFile);
+    
+    assert(content.find("Async message 0") != std::string::npos);
+    assert(content.find("Async message 99") != std::string::npos);
+    
+    // With the worker held in a sink, a one-slot queue keeps the first
+    // message and overwrites it with each of the next four
+    auto gate = std::make_shared<BlockingSink>();
+    LoggerOptions lossy;
+    lossy.async = AsyncOptions{1, 1, OverflowPolicy::OverwriteOldest};
+    lossy.extraSinks = {gate};
+    auto lossyLogger = CreateLogger(LogLevel::Info, "AsyncOverwriteTest", lossy);
+    assert(lossyLogger != nullptr);
+    gate->entered.wait();
+    for (int i = 0; i < 5; ++i) {
+        lossyLogger->info(std::format("Overflow message {}", i));
+    }
+    assert(DroppedMessageCount("AsyncOverwriteTest") == 4);
+    gate->release.count_down();
+    lossyLogger->flush();
+    std::filesystem::remove("AsyncOverwriteTest.log");
+    
+    // DropNewest needs spdlog support, and says so instead of returning nullptr
+    LoggerOptions dropNewest;
+    dropNewest.console = false;
+    dropNewest.async = AsyncOptions{1, 1, OverflowPolicy::DropNewest};
+#if SPDLOG_VERSION >= 11300
+    assert(CreateLogger(LogLevel::Info, "AsyncDropNewestTest", dropNewest) != nullptr);
+    std::filesystem::remove("AsyncDropNewestTest.log");
+#else
+    [[maybe_unused]] bool threw = false;
+    try {
+        CreateLogger(LogLevel::Info, "AsyncDropNewestTest", dropNewest);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+#endif
+    
+    // Synchronous loggers never report drops
+    assert(DroppedMessageCount("FileTest") == 0);
+    
+    std::cout << "✓ Async logging tests passed\n";
+}
+
+void test_get_or_create() {
+    std::cout << "Testing get-or-create...\n";
+    
+    auto first = CreateLogger(LogLevel::Info, "GetOrCreateTest");
+    auto second = CreateLogger(LogLevel::Debug, "GetOrCreateTest");
+    assert(first != nullptr);
+    assert(second == first);
+    
+    // The existing logger is returned unchanged
+    assert(second->level() == spdlog::level::info);
+    
+    std::filesystem::remove("GetOrCreateTest.log");
+    
+    std::cout << "✓ Get-or-create tests passed\n";
+}
+
+std::size_t openFileDescriptors() {
+    return static_cast<std::size_t>(std::distance(std::filesystem::directory_iterator("/proc/self/fd"),
+                                                  std::filesystem::directory_iterator{}));
+}
+
+void test_logger_factory() {
+    std::cout << "Testing logger factory...\n";
+    
+    LoggerOptions options;
+    options.console = false;
+    LoggerFactory factory("FactoryTest", options);
+    assert(factory.sinks().size() == 1);
+    
+    [[maybe_unused]] const std::size_t fdsBefore = openFileDescriptors();
+    std::vector<std::shared_ptr<spdlog::logger>> components;
+    for (int i = 0; i < 200; ++i) {
+        auto component = factory.get(std::format("Component{}", i));
+        assert(component != nullptr);
+        assert(component->sinks() == factory.sinks());
+        components.push_back(component);
+    }
+    
+    // No file is opened per logger
+    assert(openFileDescriptors() == fdsBefore);
+    
+    // Repeated names return the registered logger
+    assert(factory.get("Component7") == components[7]);
+    assert(spdlog::get("Component7") == components[7]);
+    
+    // Names registered elsewhere are reused rather than failing
+    auto standalone = CreateLogger(LogLevel::Info, "FactoryStandalone");
+    assert(factory.get("FactoryStandalone") == standalone);
+    std::filesystem::remove("FactoryStandalone.log");
+    
+    auto debug = factory.get("FactoryDebug", LogLevel::Debug);
+    assert(debug->level() == spdlog::level::debug);
+    
+    LOG_INFO(components[0], "from component {}", 0);
+    LOG_WARNING(components[199], "from component {}", 199);
+    for (const auto& sink : factory.sinks()) {
+        sink->flush();
+    }
+    
+    std::ifstream file("FactoryTest.log");
+    std::string content((std::istreambuf_iterator<char>(file)),
+                        std::istreambuf_iterator<char>());
+    file.close();
+    std::filesystem::remove("FactoryTest.log");
+    
+    assert(content.find("[Component0] [info] from component 0") != std::string::npos);
+    assert(content.find("[Component199] [warning] from component 199") != std::string::npos);
+    
+    std::cout << "✓ Logger factory tests passed\n";
+}
+
+void test_log_macros() {
+    std::cout << "Testing log macros...\n";
+    
+    auto logger = CreateLogger(LogLevel::Warning, "MacroTest");
+    assert(logger != nullptr);
+    
+    int evaluations = 0;
+    auto counted = [&evaluations] { return ++evaluations; };
+    
+    // Compiled out: arguments are never evaluated
+    LOG_DEBUG(logger, "debug {}", counted());
+    assert(evaluations == 0);
+    
+    // Compiled in but below the runtime level: still not evaluated
+    LOG_INFO(logger, "info {}", counted());
+    assert(evaluations == 0);
+    
+    // Enabled: formatted lazily by spdlog
+    LOG_WARNING(logger, "warning {} of {}", counted(), 2);
+    LOG_ERROR(logger, "error {}", counted());
+    assert(evaluations == 2);
+    logger->flush();
+    
+    std::ifstream file("MacroTest.log");
+    std::string content((std::istreambuf_iterator<char>(file)),
+                        std::istreambuf_iterator<char>());
+    file.close();
+    std::filesystem::remove("MacroTest.log");
+    
+    assert(content.find("warning 1 of 2") != std::string::npos);
+    assert(content.find("error 2") != std::string::npos);
+    assert(content.find("info 1") == std::string::npos);
+    
+    std::cout << "✓ Log macro tests passed\n";
+}
+
 int main() {
     std::cout << "Running Logging Tests\n";
     std::cout << "====================\n";
@@ -98,6 +310,10 @@ int main() {
     test_log_levels();
     test_log_messages();
     test_file_logging();
+    test_async_logging();
+    test_get_or_create();
+    test_logger_factory();
+    test_log_macros();
     
     std::cout << "\n✓ All logging tests passed!\n";
     return 0;
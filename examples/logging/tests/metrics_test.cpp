@@ -0,0 +1,355 @@
+#include "logger/logger.hpp"
+#include "logger/binary_sink.hpp"
+#include "logger/metrics.hpp"
+#include <spdlog/sinks/null_sink.h>
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <atomic>
+#include <cassert>
+#include <latch>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace logger;
+
+namespace {
+
+constexpr std::size_t kDebug = static_cast<std::size_t>(LogLevel::Debug);
+constexpr std::size_t kInfo = static_cast<std::size_t>(LogLevel::Info);
+constexpr std::size_t kWarning = static_cast<std::size_t>(LogLevel::Warning);
+constexpr std::size_t kError = static_cast<std::size_t>(LogLevel::Error);
+
+LoggerOptions fileOnly() {
+    LoggerOptions options;
+    options.console = false;
+    return options;
+}
+
+[[maybe_unused]] std::uint64_t total(const LevelCounts& counts) {
+    std::uint64_t sum = 0;
+    for (std::uint64_t count : counts) {
+        sum += count;
+    }
+    return sum;
+}
+
+// Holds the async worker inside its first message until released, so the
+// queue fills deterministically
+class BlockingSink : public spdlog::sinks::sink {
+public:
+    void log(const spdlog::details::log_msg&) override {
+        if (!blocked_.exchange(true)) {
+            entered.count_down();
+            release.wait();
+        }
+    }
+    void flush() override {}
+    void set_pattern(const std::string&) override {}
+    void set_formatter(std::unique_ptr<spdlog::formatter>) override {}
+
+    std::latch entered{1};
+    std::latch release{1};
+
+private:
+    std::atomic<bool> blocked_{false};
+};
+
+} // namespace
+
+void test_logger_counters() {
+    std::cout << "Testing logger and sink counters...\n";
+
+    auto log = CreateLogger(LogLevel::Info, "MetricsCounters", fileOnly());
+    assert(log != nullptr);
+
+    for (int i = 0; i < 3; ++i) {
+        LOG_DEBUG(log, "filtered {}", i);
+    }
+    for (int i = 0; i < 5; ++i) {
+        LOG_INFO(log, "info {}", i);
+    }
+    LOG_ERROR(log, "error {}", 1);
+    LOG_ERROR(log, "error {}", 2);
+    log->flush();
+
+    const auto metrics = SnapshotMetrics("MetricsCounters");
+    assert(metrics.has_value());
+    assert(metrics->name == "MetricsCounters");
+    assert(metrics->emitted[kInfo] == 5 && metrics->emitted[kError] == 2 && metrics->emitted[kDebug] == 0);
+    assert(metrics->filtered[kDebug] == 3 && total(metrics->filtered) == 3);
+
+    assert(metrics->logCall.count == 7);
+    assert(metrics->logCall.p50 <= metrics->logCall.p99 && metrics->logCall.p99 <= metrics->logCall.max);
+    assert(metrics->logCall.max.count() > 0);
+    assert(metrics->queueDepth == 0 && metrics->dropped == 0);
+
+    // The sink also sees the "initialized" message logged without a macro
+    assert(metrics->sinks.size() == 1);
+    [[maybe_unused]] const SinkMetrics& sink = metrics->sinks[0];
+    assert(sink.name == "MetricsCounters.log");
+    assert(sink.records[kInfo] == 6 && sink.records[kError] == 2 && total(sink.records) == 8);
+    assert(sink.bytes == std::filesystem::file_size("MetricsCounters.log"));
+
+    // flush_on(err) flushes once per error, plus the explicit flush
+    assert(sink.flushes == 3);
+
+    std::filesystem::remove("MetricsCounters.log");
+
+    std::cout << "✓ Logger and sink counter tests passed\n";
+}
+
+void test_thread_counters() {
+    std::cout << "Testing per-thread counters...\n";
+
+    auto log = CreateLogger(LogLevel::Info, "MetricsThreads", fileOnly());
+    assert(log != nullptr);
+
+    // Counts from threads that have exited are kept
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&log, t] {
+            for (int i = 0; i < 1000; ++i) {
+                LOG_INFO(log, "thread {} item {}", t, i);
+                LOG_DEBUG(log, "thread {} filtered {}", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    LOG_WARNING(log, "main thread");
+    log->flush();
+
+    const auto metrics = SnapshotMetrics("MetricsThreads");
+    assert(metrics.has_value());
+    assert(metrics->emitted[kInfo] == 4000 && metrics->emitted[kWarning] == 1);
+    assert(metrics->filtered[kDebug] == 4000);
+    assert(metrics->logCall.count == 4001);
+    assert(metrics->sinks[0].bytes == std::filesystem::file_size("MetricsThreads.log"));
+
+    std::filesystem::remove("MetricsThreads.log");
+
+    std::cout << "✓ Per-thread counter tests passed\n";
+}
+
+void test_foreign_loggers() {
+    std::cout << "Testing loggers without metrics...\n";
+
+    // The macros accept any spdlog logger; only ours are metered
+    auto plain = std::make_shared<spdlog::logger>("MetricsPlain", std::make_shared<spdlog::sinks::null_sink_mt>());
+    spdlog::register_logger(plain);
+    LOG_INFO(plain, "not counted {}", 1);
+    LOG_DEBUG(plain, "not counted {}", 2);
+    assert(!SnapshotMetrics("MetricsPlain").has_value());
+    assert(!SnapshotMetrics("MetricsMissing").has_value());
+    spdlog::drop("MetricsPlain");
+
+    std::cout << "✓ Loggers without metrics tests passed\n";
+}
+
+void test_sink_bytes() {
+    std::cout << "Testing byte counts per sink type...\n";
+
+    // The writer thread never wakes on its own, so the only flush is ours
+    LoggerOptions buffered = fileOnly();
+    buffered.buffered = BufferedSinkOptions{};
+    buffered.buffered->flushBytes = 1 << 20;
+    buffered.buffered->flushInterval = std::chrono::milliseconds(60000);
+    auto bufferedLog = CreateLogger(LogLevel::Info, "MetricsBuffered", buffered);
+    assert(bufferedLog != nullptr);
+
+    LoggerOptions binary = fileOnly();
+    binary.fileFormat = FileFormat::Binary;
+    auto binaryLog = CreateLogger(LogLevel::Info, "MetricsBinary", binary);
+    assert(binaryLog != nullptr);
+
+    for (int i = 0; i < 500; ++i) {
+        LOG_INFO(bufferedLog, "buffered line {}", i);
+        LOG_INFO(binaryLog, "binary record {}", i);
+    }
+    bufferedLog->flush();
+    binaryLog->flush();
+
+    // Per-thread formatter clones of the buffered sink count too
+    const auto bufferedMetrics = SnapshotMetrics("MetricsBuffered");
+    assert(bufferedMetrics->sinks[0].bytes == std::filesystem::file_size("MetricsBuffered.log"));
+    assert(bufferedMetrics->sinks[0].flushes == 1);
+
+    const auto binaryMetrics = SnapshotMetrics("MetricsBinary");
+    std::uintmax_t segmentBytes = 0;
+    for (const auto& segment : ListBinaryLogSegments("MetricsBinary")) {
+        segmentBytes += std::filesystem::file_size(segment);
+    }
+    assert(binaryMetrics->sinks[0].name == "MetricsBinary");
+    assert(binaryMetrics->sinks[0].bytes == segmentBytes);
+
+    std::filesystem::remove("MetricsBuffered.log");
+    for (const auto& segment : ListBinaryLogSegments("MetricsBinary")) {
+        std::filesystem::remove(segment);
+    }
+
+    std::cout << "✓ Byte count tests passed\n";
+}
+
+void test_short_lived_sinks() {
+    std::cout << "Testing counters of short-lived sinks on one thread...\n";
+
+    // Each new sink drops this thread's shards of the destroyed ones; the
+    // live sink still counts only its own records
+    for (int i = 0; i < 50; ++i) {
+        auto sink = std::make_shared<MeteredSink>(std::make_shared<spdlog::sinks::null_sink_mt>(), "ShortLived");
+        spdlog::logger logger("MetricsShortLived", sink);
+        for (int j = 0; j <= i % 3; ++j) {
+            logger.info("record {}", j);
+        }
+        assert(sink->snapshot().records[kInfo] == static_cast<std::uint64_t>(i % 3 + 1));
+    }
+
+    std::cout << "✓ Short-lived sink tests passed\n";
+}
+
+void test_buffered_batch_flushes() {
+    std::cout << "Testing buffered sink batch flushes...\n";
+
+    // Full buffers wake the writer thread, which writes without flush()
+    LoggerOptions options = fileOnly();
+    options.buffered = BufferedSinkOptions{};
+    options.buffered->flushBytes = 64;
+    options.buffered->flushInterval = std::chrono::milliseconds(60000);
+    auto log = CreateLogger(LogLevel::Info, "MetricsBatches", options);
+    assert(log != nullptr);
+    for (int i = 0; i < 100; ++i) {
+        LOG_INFO(log, "batched line {}", i);
+    }
+
+    std::uint64_t flushes = 0;
+    for (int attempt = 0; attempt < 100 && flushes == 0; ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        flushes = SnapshotMetrics("MetricsBatches")->sinks[0].flushes;
+    }
+    assert(flushes > 0);
+
+    log->flush();
+    const SinkMetrics sink = SnapshotMetrics("MetricsBatches")->sinks[0];
+    assert(sink.flushes > flushes);
+    assert(sink.flushTime.count() > 0);
+    assert(sink.bytes == std::filesystem::file_size("MetricsBatches.log"));
+    std::filesystem::remove("MetricsBatches.log");
+
+    std::cout << "✓ Buffered sink batch flush tests passed\n";
+}
+
+void test_async_and_factory() {
+    std::cout << "Testing async and factory loggers...\n";
+
+    // Emitted counts every accepted call; drops are reported separately.
+    // The worker is held in the initialization message, so of the five
+    // calls one waits in the one-slot queue and four overwrite it.
+    auto gate = std::make_shared<BlockingSink>();
+    LoggerOptions lossy = fileOnly();
+    lossy.async = AsyncOptions{1, 1, OverflowPolicy::OverwriteOldest};
+    lossy.extraSinks = {gate};
+    auto asyncLog = CreateLogger(LogLevel::Info, "MetricsAsync", lossy);
+    assert(asyncLog != nullptr);
+    gate->entered.wait();
+    for (int i = 0; i < 5; ++i) {
+        LOG_INFO(asyncLog, "queued {}", i);
+    }
+    const auto asyncMetrics = SnapshotMetrics("MetricsAsync");
+    assert(asyncMetrics->emitted[kInfo] == 5);
+    assert(asyncMetrics->queueDepth == 1);
+    assert(asyncMetrics->dropped == 4 && asyncMetrics->dropped == DroppedMessageCount("MetricsAsync"));
+    gate->release.count_down();
+    asyncLog->flush();
+    std::filesystem::remove("MetricsAsync.log");
+
+    // Loggers of one factory report the shared sink's totals
+    LoggerFactory factory("MetricsFactory", fileOnly());
+    auto first = factory.get("MetricsFactoryA");
+    auto second = factory.get("MetricsFactoryB");
+    LOG_INFO(first, "from {}", "A");
+    LOG_WARNING(second, "from {}", "B");
+
+    const auto a = SnapshotMetrics("MetricsFactoryA");
+    const auto b = SnapshotMetrics("MetricsFactoryB");
+    assert(a->emitted[kInfo] == 1 && a->emitted[kWarning] == 0);
+    assert(b->emitted[kWarning] == 1 && b->emitted[kInfo] == 0);
+    assert(a->sinks[0].records == b->sinks[0].records);
+    assert(a->sinks[0].records[kInfo] == 3 && a->sinks[0].records[kWarning] == 1);
+    std::filesystem::remove("MetricsFactory.log");
+
+    // Every metered logger is listed, sorted by name
+    const auto all = SnapshotMetrics();
+    bool foundA = false;
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        assert(i == 0 || all[i - 1].name < all[i].name);
+        foundA = foundA || all[i].name == "MetricsFactoryA";
+        assert(all[i].name != "MetricsPlain");
+    }
+    assert(foundA);
+
+    std::cout << "✓ Async and factory tests passed\n";
+}
+
+void test_metrics_dump() {
+    std::cout << "Testing metrics formatting and periodic dump...\n";
+
+    auto log = CreateLogger(LogLevel::Info, "MetricsDump", fileOnly());
+    LOG_INFO(log, "dumped {}", 1);
+
+    const std::string line = FormatMetrics(*SnapshotMetrics("MetricsDump"));
+    assert(line.find("logger=MetricsDump emitted=0,1,0,0,0 filtered=0,0,0,0,0 calls=1 ") == 0);
+    assert(line.find("\n  sink=MetricsDump.log records=0,2,0,0,0 bytes=") != std::string::npos);
+
+    const std::string path = "metrics_test.metrics.log";
+    std::filesystem::remove(path);
+    {
+        MetricsDumper dumper(MetricsDumpOptions{path, std::chrono::milliseconds(10)});
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    std::ifstream file(path);
+    std::string content((std::istreambuf_iterator<char>(file)),
+                        std::istreambuf_iterator<char>());
+    file.close();
+    std::filesystem::remove(path);
+    std::filesystem::remove("MetricsDump.log");
+
+    // Periodic dumps plus the final one on destruction
+    std::size_t dumps = 0;
+    for (auto pos = content.find("] logger=MetricsDump "); pos != std::string::npos;
+         pos = content.find("] logger=MetricsDump ", pos + 1)) {
+        ++dumps;
+    }
+    assert(dumps >= 2);
+    assert(content.front() == '[');
+
+    [[maybe_unused]] bool threw = false;
+    try {
+        MetricsDumper invalid(MetricsDumpOptions{path, std::chrono::milliseconds(0)});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✓ Metrics dump tests passed\n";
+}
+
+int main() {
+    std::cout << "Running Logger Metrics Tests\n";
+    std::cout << "===========================\n";
+
+    test_logger_counters();
+    test_thread_counters();
+    test_foreign_loggers();
+    test_sink_bytes();
+    test_short_lived_sinks();
+    test_buffered_batch_flushes();
+    test_async_and_factory();
+    test_metrics_dump();
+
+    std::cout << "\n✓ All logger metrics tests passed!\n";
+    return 0;
+}
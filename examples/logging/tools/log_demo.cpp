@@ -1,7 +1,6 @@
 #include "logger/logger.hpp"
 #include <thread>
 #include <chrono>
-#include <format>
 #include <iostream>
 
 using namespace logger;
@@ -18,30 +17,30 @@ int main() {
     std::cout << "==============================================================\n\n";
     
     // Test different log levels
-    log->debug("This is a debug message");
-    log->info("Application started successfully");
-    log->warn("This is a warning message");
-    log->error("This is an error message");
-    log->critical("This is a critical message");
+    LOG_DEBUG(log, "This is a debug message");
+    LOG_INFO(log, "Application started successfully");
+    LOG_WARNING(log, "This is a warning message");
+    LOG_ERROR(log, "This is an error message");
+    LOG_CRITICAL(log, "This is a critical message");
     
-    // Test with std::format
+    // Deferred formatting: arguments are only formatted if the level is enabled
     int value = 42;
     double pi = 3.14159;
     std::string name = "World";
     
-    log->info(std::format("Formatted message: value={}, pi={:.2f}, greeting='Hello {}'", value, pi, name));
+    LOG_INFO(log, "Formatted message: value={}, pi={:.2f}, greeting='Hello {}'", value, pi, name);
     
     // Simulate some application work
     for (int i = 1; i <= 5; ++i) {
-        log->info(std::format("Processing item {}/5", i));
+        LOG_INFO(log, "Processing item {}/5", i);
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
         
         if (i == 3) {
-            log->warn(std::format("Item {} required special handling", i));
+            LOG_WARNING(log, "Item {} required special handling", i);
         }
     }
     
-    log->info("Demo completed successfully");
+    LOG_INFO(log, "Demo completed successfully");
     
     return 0;
 }
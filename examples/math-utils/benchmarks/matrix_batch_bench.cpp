@@ -0,0 +1,65 @@
+#include "math-utils/matrix_batch.hpp"
+#include <benchmark/benchmark.h>
+#include <stdexcept>
+#include <vector>
+
+using namespace math_utils;
+
+namespace {
+
+std::vector<Matrix3x3> matrices(std::size_t count) {
+    std::vector<Matrix3x3> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const double s = static_cast<double>(i % 97) * 0.01;
+        result.push_back(Matrix3x3({{{2.0 + s, 0.5, -1.0}, {0.25, 3.0 - s, 0.75}, {1.0, s, 4.0}}}));
+    }
+    return result;
+}
+
+} // namespace
+
+// Baseline: Matrix3x3::inverse() per matrix with exception-based reporting
+static void BM_InversePerMatrix(benchmark::State& state) {
+    const std::vector<Matrix3x3> in = matrices(static_cast<std::size_t>(state.range(0)));
+    std::vector<Matrix3x3> out(in.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < in.size(); ++i) {
+            try {
+                out[i] = in[i].inverse();
+            } catch (const std::runtime_error&) {
+                out[i] = Matrix3x3::zero();
+            }
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InversePerMatrix)->Arg(1 << 20)->UseRealTime();
+
+// Second argument is the pool size; scaling needs that many cores
+static void BM_InverseBatch(benchmark::State& state) {
+    const std::vector<Matrix3x3> in = matrices(static_cast<std::size_t>(state.range(0)));
+    std::vector<Matrix3x3> out(in.size());
+    std::vector<InverseStatus> status(in.size());
+    ThreadPool pool(static_cast<std::size_t>(state.range(1)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(inverseBatch(in, out, status, pool));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InverseBatch)->ArgsProduct({{1 << 20}, {1, 2, 4, 8}})->UseRealTime();
+
+static void BM_DeterminantBatch(benchmark::State& state) {
+    const std::vector<Matrix3x3> in = matrices(static_cast<std::size_t>(state.range(0)));
+    std::vector<double> out(in.size());
+    ThreadPool pool(static_cast<std::size_t>(state.range(1)));
+    for (auto _ : state) {
+        determinantBatch(in, out, pool);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DeterminantBatch)->ArgsProduct({{1 << 20}, {1, 2, 4, 8}})->UseRealTime();
+
+BENCHMARK_MAIN();
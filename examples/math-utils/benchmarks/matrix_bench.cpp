@@ -0,0 +1,215 @@
+#include "math-utils/matrix.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace math_utils;
+
+namespace {
+
+Matrix3x3 general() {
+    return Matrix3x3({{{4.0, -1.0, 0.5}, {1.0, 3.0, -2.0}, {0.25, 2.0, 5.0}}});
+}
+
+Matrix3x3 symmetric() {
+    return Matrix3x3({{{4.0, 1.0, 0.5}, {1.0, 3.0, -2.0}, {0.5, -2.0, 5.0}}});
+}
+
+} // namespace
+
+static void BM_Matrix3x3Identity(benchmark::State& state) {
+    for (auto _ : state) {
+        Matrix3x3 m = Matrix3x3::identity();
+        benchmark::DoNotOptimize(m);
+    }
+}
+BENCHMARK(BM_Matrix3x3Identity);
+
+static void BM_Matrix3x3Random(benchmark::State& state) {
+    for (auto _ : state) {
+        Matrix3x3 m = Matrix3x3::random();
+        benchmark::DoNotOptimize(m);
+    }
+}
+BENCHMARK(BM_Matrix3x3Random);
+
+static void BM_Matrix3x3ElementAccess(benchmark::State& state) {
+    Matrix3x3 m = general();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m);
+        double sum = 0.0;
+        for (int row = 0; row < 3; ++row) {
+            for (int col = 0; col < 3; ++col) {
+                sum += m(row, col);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_Matrix3x3ElementAccess);
+
+static void BM_Matrix3x3ElementAccessUnchecked(benchmark::State& state) {
+    Matrix3x3 m = general();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m);
+        double sum = 0.0;
+        for (int row = 0; row < 3; ++row) {
+            for (int col = 0; col < 3; ++col) {
+                sum += m.at_unchecked(row, col);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_Matrix3x3ElementAccessUnchecked);
+
+static void BM_Matrix3x3Add(benchmark::State& state) {
+    Matrix3x3 a = general(), b = symmetric();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Matrix3x3 r = a + b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Matrix3x3Add);
+
+static void BM_Matrix3x3Subtract(benchmark::State& state) {
+    Matrix3x3 a = general(), b = symmetric();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Matrix3x3 r = a - b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Matrix3x3Subtract);
+
+static void BM_Matrix3x3Multiply(benchmark::State& state) {
+    Matrix3x3 a = general(), b = symmetric();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Matrix3x3 r = a * b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Matrix3x3Multiply);
+
+static void BM_Matrix3x3MultiplyVector(benchmark::State& state) {
+    Matrix3x3 a = general();
+    Vector3 v(1.0, -2.0, 0.5);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(v);
+        Vector3 r = a * v;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Matrix3x3MultiplyVector);
+
+static void BM_Matrix3x3ScalarMultiply(benchmark::State& state) {
+    Matrix3x3 a = general();
+    double s = 0.5;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(s);
+        Matrix3x3 r = a * s;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Matrix3x3ScalarMultiply);
+
+static void BM_Matrix3x3Transpose(benchmark::State& state) {
+    Matrix3x3 a = general();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Matrix3x3 r = a.transpose();
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Matrix3x3Transpose);
+
+static void BM_Matrix3x3Determinant(benchmark::State& state) {
+    Matrix3x3 a = general();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.determinant());
+    }
+}
+BENCHMARK(BM_Matrix3x3Determinant);
+
+static void BM_Matrix3x3Inverse(benchmark::State& state) {
+    Matrix3x3 a = general();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Matrix3x3 r = a.inverse();
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Matrix3x3Inverse);
+
+static void BM_Matrix3x3Trace(benchmark::State& state) {
+    Matrix3x3 a = general();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.trace());
+    }
+}
+BENCHMARK(BM_Matrix3x3Trace);
+
+static void BM_Matrix3x3Norm(benchmark::State& state) {
+    Matrix3x3 a = general();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.norm());
+    }
+}
+BENCHMARK(BM_Matrix3x3Norm);
+
+static void BM_Matrix3x3IsSymmetric(benchmark::State& state) {
+    Matrix3x3 a = symmetric();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.isSymmetric());
+    }
+}
+BENCHMARK(BM_Matrix3x3IsSymmetric);
+
+static void BM_Matrix3x3EigenvaluesGeneral(benchmark::State& state) {
+    Matrix3x3 a = general();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Eigen::Vector3d values = a.eigenvalues();
+        benchmark::DoNotOptimize(values);
+    }
+}
+BENCHMARK(BM_Matrix3x3EigenvaluesGeneral);
+
+static void BM_Matrix3x3EigenvaluesSymmetric(benchmark::State& state) {
+    Matrix3x3 a = symmetric();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Eigen::Vector3d values = a.eigenvalues();
+        benchmark::DoNotOptimize(values);
+    }
+}
+BENCHMARK(BM_Matrix3x3EigenvaluesSymmetric);
+
+static void BM_Matrix3x3SymmetricEigen(benchmark::State& state) {
+    Matrix3x3 a = symmetric();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        SymmetricEigenDecomposition decomposition = a.symmetricEigen();
+        benchmark::DoNotOptimize(decomposition);
+    }
+}
+BENCHMARK(BM_Matrix3x3SymmetricEigen);
+
+// (a * b)^T + a evaluated through the expression templates
+static void BM_Matrix3x3ChainedExpression(benchmark::State& state) {
+    Matrix3x3 a = general(), b = symmetric();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Matrix3x3 r = Matrix3x3(a * b).transpose() + a;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Matrix3x3ChainedExpression);
+
+BENCHMARK_MAIN();
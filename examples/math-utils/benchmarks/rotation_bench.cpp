@@ -0,0 +1,116 @@
+#include "math-utils/rotation.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace math_utils;
+
+namespace {
+
+Rotation rotationA() { return Rotation::fromAxisAngle(Vector3(0.2, 1.0, -0.3), 1.1); }
+Rotation rotationB() { return Rotation::fromAxisAngle(Vector3(-1.0, 0.4, 0.9), -0.6); }
+
+} // namespace
+
+// Baseline: chaining rotations as matrices
+static void BM_Matrix3x3Compose(benchmark::State& state) {
+    Matrix3x3 a = rotationA().toMatrix(), b = rotationB().toMatrix();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Matrix3x3 r = a * b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Matrix3x3Compose);
+
+static void BM_RotationCompose(benchmark::State& state) {
+    Rotation a = rotationA(), b = rotationB();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Rotation r = a * b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_RotationCompose);
+
+static void BM_RigidTransformCompose(benchmark::State& state) {
+    RigidTransform a(rotationA(), Vector3(1.0, 2.0, 3.0)), b(rotationB(), Vector3(-0.5, 0.0, 4.0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        RigidTransform r = a * b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_RigidTransformCompose);
+
+static void BM_RotationInverse(benchmark::State& state) {
+    Rotation a = rotationA();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Rotation r = a.inverse();
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_RotationInverse);
+
+static void BM_RotationApply(benchmark::State& state) {
+    Rotation a = rotationA();
+    Vector3 p(1.5, -0.25, 2.0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(p);
+        Vector3 r = a.apply(p);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_RotationApply);
+
+static void BM_RotationToMatrix(benchmark::State& state) {
+    Rotation a = rotationA();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Matrix3x3 m = a.toMatrix();
+        benchmark::DoNotOptimize(m);
+    }
+}
+BENCHMARK(BM_RotationToMatrix);
+
+// Per-point apply against the batched path over a point cloud
+static void BM_RigidTransformApplyPerPoint(benchmark::State& state) {
+    const RigidTransform t(rotationA(), Vector3(1.0, 2.0, 3.0));
+    std::vector<Vector3> in(static_cast<std::size_t>(state.range(0)), Vector3(1.5, -0.25, 2.0));
+    std::vector<Vector3> out(in.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < in.size(); ++i) {
+            out[i] = t.apply(in[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RigidTransformApplyPerPoint)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_RigidTransformApplyBatch(benchmark::State& state) {
+    const RigidTransform t(rotationA(), Vector3(1.0, 2.0, 3.0));
+    std::vector<Vector3> in(static_cast<std::size_t>(state.range(0)), Vector3(1.5, -0.25, 2.0));
+    std::vector<Vector3> out(in.size());
+    for (auto _ : state) {
+        transformPoints(t, in, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RigidTransformApplyBatch)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_RigidTransformfApplyBatch(benchmark::State& state) {
+    const RigidTransformf t = RigidTransform(rotationA(), Vector3(1.0, 2.0, 3.0)).cast<float>();
+    std::vector<Vector3f> in(static_cast<std::size_t>(state.range(0)), Vector3f(1.5f, -0.25f, 2.0f));
+    std::vector<Vector3f> out(in.size());
+    for (auto _ : state) {
+        transformPoints(t, in, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RigidTransformfApplyBatch)->Arg(1 << 10)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,109 @@
+#include "math-utils/transform.hpp"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+using namespace math_utils;
+
+// Throughput of transforming state.range(0) points; items/s is points/s
+
+namespace {
+
+std::vector<Vector3> makePoints(std::size_t count) {
+    std::vector<Vector3> points;
+    points.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        points.emplace_back(0.001 * i, 1.0 - 0.002 * i, 0.5);
+    }
+    return points;
+}
+
+const Matrix3x3 kMatrix({{{0.0, -1.0, 0.5}, {1.0, 0.25, 0.0}, {-0.5, 0.0, 2.0}}});
+const Vector3 kTranslation(1.0, -2.0, 3.0);
+
+// Runs fn at the requested SIMD level; only supported levels are registered
+template <typename Fn>
+void atLevel(benchmark::State& state, SimdLevel level, Fn&& fn) {
+    const SimdLevel previous = simdLevel();
+    setSimdLevel(level);
+    fn();
+    setSimdLevel(previous);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+// Baseline: one operator* per point
+static void BM_TransformPerPoint(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto points = makePoints(count);
+    std::vector<Vector3> out(count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = kMatrix * points[i] + kTranslation;
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TransformPerPoint)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_TransformPointsAoS(benchmark::State& state, SimdLevel level) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto points = makePoints(count);
+    std::vector<Vector3> out(count);
+    atLevel(state, level, [&] {
+        for (auto _ : state) {
+            transformPoints(kMatrix, points, out, kTranslation);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+    });
+}
+
+static void BM_TransformPointsSoA(benchmark::State& state, SimdLevel level) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    Vector3Batch batch(makePoints(count));
+    Vector3Batch out(count);
+    atLevel(state, level, [&] {
+        for (auto _ : state) {
+            transformPoints(kMatrix, batch, out, kTranslation);
+            benchmark::DoNotOptimize(out.xs().data());
+            benchmark::ClobberMemory();
+        }
+    });
+}
+
+// Levels the CPU lacks are not registered rather than reported as errors, so
+// results from different machines differ only in which benchmarks exist.
+// Names match BENCHMARK_CAPTURE, e.g. BM_TransformPointsAoS/AVX2/1024.
+static void registerSimdBenchmarks() {
+    struct Level {
+        SimdLevel level;
+        const char* name;
+    };
+    for (const Level& l : {Level{SimdLevel::Scalar, "Scalar"}, Level{SimdLevel::AVX2, "AVX2"},
+                           Level{SimdLevel::AVX512, "AVX512"}}) {
+        if (!simdLevelSupported(l.level)) {
+            continue;
+        }
+        benchmark::RegisterBenchmark((std::string("BM_TransformPointsAoS/") + l.name).c_str(),
+                                     BM_TransformPointsAoS, l.level)
+            ->Arg(1 << 10)->Arg(1 << 20);
+        benchmark::RegisterBenchmark((std::string("BM_TransformPointsSoA/") + l.name).c_str(),
+                                     BM_TransformPointsSoA, l.level)
+            ->Arg(1 << 10)->Arg(1 << 20);
+    }
+}
+
+int main(int argc, char** argv) {
+    registerSimdBenchmarks();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include "math-utils/vector.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace math_utils;
+
+// Operands are passed through DoNotOptimize so every operation is computed
+// at run time rather than folded from constants.
+
+namespace {
+
+Vector3 lhs() { return Vector3(1.5, -2.25, 3.125); }
+Vector3 rhs() { return Vector3(-0.75, 4.5, 0.875); }
+
+} // namespace
+
+static void BM_Vector3Construct(benchmark::State& state) {
+    double x = 1.0, y = 2.0, z = 3.0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        Vector3 v(x, y, z);
+        benchmark::DoNotOptimize(v);
+    }
+}
+BENCHMARK(BM_Vector3Construct);
+
+static void BM_Vector3Add(benchmark::State& state) {
+    Vector3 a = lhs(), b = rhs();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Vector3 r = a + b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Vector3Add);
+
+static void BM_Vector3Subtract(benchmark::State& state) {
+    Vector3 a = lhs(), b = rhs();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Vector3 r = a - b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Vector3Subtract);
+
+static void BM_Vector3Negate(benchmark::State& state) {
+    Vector3 a = lhs();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Vector3 r = -a;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Vector3Negate);
+
+static void BM_Vector3ScalarMultiply(benchmark::State& state) {
+    Vector3 a = lhs();
+    double s = 2.5;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(s);
+        Vector3 r = a * s;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Vector3ScalarMultiply);
+
+static void BM_Vector3ScalarDivide(benchmark::State& state) {
+    Vector3 a = lhs();
+    double s = 2.5;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(s);
+        Vector3 r = a / s;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Vector3ScalarDivide);
+
+static void BM_Vector3Magnitude(benchmark::State& state) {
+    Vector3 a = lhs();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.magnitude());
+    }
+}
+BENCHMARK(BM_Vector3Magnitude);
+
+static void BM_Vector3SquaredNorm(benchmark::State& state) {
+    Vector3 a = lhs();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.squaredNorm());
+    }
+}
+BENCHMARK(BM_Vector3SquaredNorm);
+
+static void BM_Vector3Normalized(benchmark::State& state) {
+    Vector3 a = lhs();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Vector3 r = a.normalized();
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Vector3Normalized);
+
+static void BM_Vector3Dot(benchmark::State& state) {
+    Vector3 a = lhs(), b = rhs();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.dot(b));
+    }
+}
+BENCHMARK(BM_Vector3Dot);
+
+static void BM_Vector3Cross(benchmark::State& state) {
+    Vector3 a = lhs(), b = rhs();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Vector3 r = a.cross(b);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Vector3Cross);
+
+static void BM_Vector3CwiseProduct(benchmark::State& state) {
+    Vector3 a = lhs(), b = rhs();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Vector3 r = a.cwiseProduct(b);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Vector3CwiseProduct);
+
+// a + b * s - c evaluated in one pass through the expression templates
+static void BM_Vector3ChainedExpression(benchmark::State& state) {
+    Vector3 a = lhs(), b = rhs(), c(0.5, 0.25, -1.0);
+    double s = 1.75;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        Vector3 r = a + b * s - c;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_Vector3ChainedExpression);
+
+// Dot products streamed over large arrays are memory bound, so single
+// precision moves half the bytes of double; Acc is the accumulation type
+template <typename T, typename Acc = T>
+static void BM_Vector3DotStream(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<Vector3T<T>> a(n, Vector3T<T>(1.5, -2.25, 3.125));
+    std::vector<Vector3T<T>> b(n, Vector3T<T>(-0.75, 4.5, 0.875));
+    for (auto _ : state) {
+        Acc sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += a[i].template dot<Acc>(b[i]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(n * 2 * sizeof(Vector3T<T>)));
+}
+BENCHMARK_TEMPLATE(BM_Vector3DotStream, double)->Arg(1 << 10)->Arg(1 << 22);
+BENCHMARK_TEMPLATE(BM_Vector3DotStream, float)->Arg(1 << 10)->Arg(1 << 22);
+BENCHMARK_TEMPLATE(BM_Vector3DotStream, float, double)->Arg(1 << 10)->Arg(1 << 22);
+
+BENCHMARK_MAIN();
@@ -13,6 +13,11 @@ in mkModule {
   ];
   fetchContentDeps = [];            # CMake FetchContent dependencies (escape hatch)
   
+  # Compile out LOG_DEBUG call sites in this module
+  buildConfig = {
+    defines.LOGGER_ACTIVE_LEVEL = "LOGGER_LEVEL_INFO";
+  };
+  
   # Set source directory to current directory
   src = ./.;
   
@@ -21,6 +26,8 @@ in mkModule {
     lib = mkLibrary {
       name = "math-utils";
       type = "static";
+      # spdlog is only used by the executables, which reuse this PCH
+      precompileHeaders = [ "<Eigen/Dense>" "<spdlog/spdlog.h>" ];
     };
     
     # Calculator executable
@@ -40,5 +47,47 @@ in mkModule {
       name = "matrix-tests";
       entrypoint = "tests/matrix_test.cpp";
     };
+
+    # Bounds checks built with the opposite NDEBUG from the library
+    bounds-check-tests = mkExecutable {
+      name = "bounds-check-tests";
+      entrypoint = "tests/bounds_check_test.cpp";
+    };
+    
+    # Batched determinant/inverse and thread pool tests
+    matrix-batch-tests = mkExecutable {
+      name = "matrix-batch-tests";
+      entrypoint = "tests/matrix_batch_test.cpp";
+    };
+    
+    # Vector batch tests
+    vector-batch-tests = mkExecutable {
+      name = "vector-batch-tests";
+      entrypoint = "tests/vector_batch_test.cpp";
+    };
+    
+    # Float/double precision tests
+    precision-tests = mkExecutable {
+      name = "precision-tests";
+      entrypoint = "tests/precision_test.cpp";
+    };
+    
+    # Quaternion rotation and rigid transform tests
+    rotation-tests = mkExecutable {
+      name = "rotation-tests";
+      entrypoint = "tests/rotation_test.cpp";
+    };
+    
+    # Memory-mapped batch pipeline tests
+    batch-file-tests = mkExecutable {
+      name = "batch-file-tests";
+      entrypoint = "tests/batch_file_test.cpp";
+    };
+    
+    # Batched transform tests
+    transform-tests = mkExecutable {
+      name = "transform-tests";
+      entrypoint = "tests/transform_test.cpp";
+    };
   };
 }
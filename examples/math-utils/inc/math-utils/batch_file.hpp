@@ -0,0 +1,86 @@
+#pragma once
+
+#include "matrix.hpp"
+#include "vector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace math_utils {
+
+// Binary batch files: a 16-byte header followed by `count` elements of
+// `width` scalars each, in native byte order. Vectors are stored as x, y, z
+// and matrices as their 9 coefficients in column-major order, the layout of
+// Vector3::data() and Matrix3x3::data().
+struct BatchFileHeader {
+    char magic[4] = {'M', 'U', 'B', '1'};
+    std::uint8_t width = 0;       // Scalars per element: 1, 3 (vectors) or 9 (matrices)
+    std::uint8_t scalarSize = 0;  // 4 (float) or 8 (double)
+    std::uint8_t reserved[2] = {};
+    std::uint64_t count = 0;
+};
+static_assert(sizeof(BatchFileHeader) == 16);
+
+// Read-only mapping of a whole file, advised for sequential access
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::span<const std::byte> bytes() const { return {data_, size_}; }
+
+private:
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// Operations of a batch pipeline. Transform and Normalize take vectors;
+// Determinant (to scalars) and Eigenvalues (to vectors, ascending for
+// symmetric input, as Matrix3x3::eigenvalues()) take matrices.
+enum class BatchOp {
+    Transform,
+    Normalize,
+    Determinant,
+    Eigenvalues
+};
+
+struct BatchStep {
+    BatchOp op = BatchOp::Transform;
+    // Transform only: p' = matrix * p + translation
+    Matrix3x3 matrix = Matrix3x3::identity();
+    Vector3 translation;
+};
+
+// Parses "normalize", "determinant", "eigenvalues" or
+// "transform:m00,m01,...,m22[,tx,ty,tz]" (matrix in row-major order);
+// throws std::invalid_argument otherwise
+BatchStep parseBatchStep(std::string_view spec);
+
+struct BatchResult {
+    std::uint64_t count = 0;
+    std::uint8_t width = 0;          // Scalars per output element
+    std::uint64_t zeroVectors = 0;   // Zero vectors Normalize left as zero
+    std::uint64_t bytesWritten = 0;  // Header included
+};
+
+// Streams a batch file through `steps` in chunks of `chunkElements`, reading
+// the input straight from the mapping and writing each chunk's results with
+// one write() to `output` ("-" for stdout). Elements keep the input
+// precision. Throws std::invalid_argument for a malformed input or a step
+// that does not accept the current element type, std::runtime_error for
+// I/O errors.
+BatchResult runBatch(const std::string& input, const std::string& output,
+                     std::span<const BatchStep> steps, std::size_t chunkElements = 1 << 16);
+
+// Write batch files from in-memory data
+void writeBatchFile(const std::string& path, std::span<const Vector3> vectors);
+void writeBatchFile(const std::string& path, std::span<const Vector3f> vectors);
+void writeBatchFile(const std::string& path, std::span<const Matrix3x3> matrices);
+void writeBatchFile(const std::string& path, std::span<const Matrix3x3f> matrices);
+
+} // namespace math_utils
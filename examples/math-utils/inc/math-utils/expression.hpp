@@ -0,0 +1,146 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <concepts>
+#include <iostream>
+#include <type_traits>
+
+// Bounds checking policy for Matrix3x3::operator()(row, col). Defaults to
+// checked in debug builds and unchecked when NDEBUG is defined; define
+// MATH_UTILS_BOUNDS_CHECK to 0 or 1 to override. The policy is a template
+// argument of operator(), so checked and unchecked callers use distinct
+// symbols and debug and release code can be linked together.
+#ifndef MATH_UTILS_BOUNDS_CHECK
+#ifdef NDEBUG
+#define MATH_UTILS_BOUNDS_CHECK 0
+#else
+#define MATH_UTILS_BOUNDS_CHECK 1
+#endif
+#endif
+
+namespace math_utils {
+
+template <typename T> class Vector3T;
+template <typename T> class Matrix3x3T;
+
+// Lazy results of Vector3/Matrix3x3 arithmetic. Operators on Vector3,
+// Matrix3x3 and these wrappers build an Eigen expression instead of
+// evaluating each step, so a chain such as `(v1 + v2) * 2.0 - v3` runs as a
+// single fused pass when it is assigned to a Vector3 (or Matrix3x3).
+//
+// Fused coefficient-wise results equal step-by-step evaluation except where
+// the compiler contracts a multiply and an add into one FMA, which changes
+// the result by at most one rounding of the intermediate product.
+//
+// Expressions also provide the read-only API of the type they evaluate to,
+// so `(a - b).dot(c)` or `(m1 * m2).determinant()` work as before; calls
+// that need the value evaluate it first.
+//
+// Like Eigen expressions, these reference their Vector3/Matrix3x3 operands.
+// Operators evaluate eagerly when an operand is a temporary Vector3 or
+// Matrix3x3 (e.g. `m.inverse() * v`), so no expression outlives the value
+// it reads; still, assign results built from named operands to a
+// Vector3/Matrix3x3 (or call eval()) rather than storing them with `auto`
+// beyond the lifetime of those operands.
+template <typename Xpr>
+class VectorExpr {
+public:
+    using Scalar = typename Xpr::Scalar;
+
+    explicit VectorExpr(const Xpr& xpr) : xpr_(xpr) {}
+
+    const Xpr& eigen() const { return xpr_; }
+    Vector3T<Scalar> eval() const;
+
+    Scalar x() const { return eval().x(); }
+    Scalar y() const { return eval().y(); }
+    Scalar z() const { return eval().z(); }
+
+    template <std::floating_point Acc = Scalar>
+    Acc magnitude() const { return xpr_.template cast<Acc>().norm(); }
+    template <std::floating_point Acc = Scalar>
+    Acc squaredNorm() const { return xpr_.template cast<Acc>().squaredNorm(); }
+    template <std::floating_point Acc = Scalar>
+    Acc dot(const Vector3T<Scalar>& other) const { return eval().template dot<Acc>(other); }
+
+    Vector3T<Scalar> normalized() const { return eval().normalized(); }
+    Vector3T<Scalar> cross(const Vector3T<Scalar>& other) const { return eval().cross(other); }
+    Vector3T<Scalar> cwiseProduct(const Vector3T<Scalar>& other) const { return eval().cwiseProduct(other); }
+
+private:
+    Xpr xpr_;
+};
+
+template <typename Xpr>
+class MatrixExpr {
+public:
+    using Scalar = typename Xpr::Scalar;
+
+    explicit MatrixExpr(const Xpr& xpr) : xpr_(xpr) {}
+
+    const Xpr& eigen() const { return xpr_; }
+    Matrix3x3T<Scalar> eval() const;
+
+    // Checked according to MATH_UTILS_BOUNDS_CHECK, like Matrix3x3
+    template <bool Checked = MATH_UTILS_BOUNDS_CHECK != 0>
+    Scalar operator()(int row, int col) const { return eval().template operator()<Checked>(row, col); }
+
+    auto transpose() const { return MatrixExpr<decltype(xpr_.transpose())>(xpr_.transpose()); }
+    Scalar trace() const { return xpr_.trace(); }
+    Scalar norm() const { return xpr_.norm(); }
+    Scalar determinant() const { return eval().determinant(); }
+    Matrix3x3T<Scalar> inverse() const { return eval().inverse(); }
+    auto eigenvalues() const { return eval().eigenvalues(); }
+    bool isSymmetric() const { return eval().isSymmetric(); }
+    auto symmetricEigen() const { return eval().symmetricEigen(); }
+
+private:
+    Xpr xpr_;
+};
+
+// Operand categories accepted by the arithmetic operators
+template <typename T> struct is_vector_operand : std::false_type {};
+template <typename T> struct is_vector_operand<Vector3T<T>> : std::true_type {};
+template <typename Xpr> struct is_vector_operand<VectorExpr<Xpr>> : std::true_type {};
+
+template <typename T> struct is_matrix_operand : std::false_type {};
+template <typename T> struct is_matrix_operand<Matrix3x3T<T>> : std::true_type {};
+template <typename Xpr> struct is_matrix_operand<MatrixExpr<Xpr>> : std::true_type {};
+
+template <typename T>
+concept VectorOperand = is_vector_operand<std::remove_cvref_t<T>>::value;
+
+template <typename T>
+concept MatrixOperand = is_matrix_operand<std::remove_cvref_t<T>>::value;
+
+template <typename T>
+using operand_scalar_t = typename std::remove_cvref_t<T>::Scalar;
+
+// Operators never mix precisions; convert one side explicitly with cast<U>()
+template <typename L, typename R>
+concept SameScalar = std::same_as<operand_scalar_t<L>, operand_scalar_t<R>>;
+
+namespace detail {
+
+template <typename T> struct is_value_operand : std::false_type {};
+template <typename T> struct is_value_operand<Vector3T<T>> : std::true_type {};
+template <typename T> struct is_value_operand<Matrix3x3T<T>> : std::true_type {};
+
+// A Vector3/Matrix3x3 bound to a forwarding reference as an rvalue; it dies
+// at the end of the full expression, so nothing may keep referencing it
+template <typename T>
+concept TemporaryValue = !std::is_lvalue_reference_v<T> && is_value_operand<std::remove_cvref_t<T>>::value;
+
+// Returns `expr` lazily unless one of the operand types is a temporary
+template <typename... Operands, typename Expr>
+auto evalIfTemporary(const Expr& expr) {
+    if constexpr ((TemporaryValue<Operands> || ...)) {
+        return expr.eval();
+    } else {
+        return expr;
+    }
+}
+
+} // namespace detail
+
+} // namespace math_utils
@@ -3,50 +3,201 @@
 #include "vector.hpp"
 #include <Eigen/Dense>
 #include <array>
+#include <concepts>
+#include <span>
 
 namespace math_utils {
 
-class Matrix3x3 {
+namespace detail {
+[[noreturn]] void throwMatrixIndexError();
+
+template <bool Checked>
+inline void checkMatrixIndex([[maybe_unused]] int row, [[maybe_unused]] int col) {
+    if constexpr (Checked) {
+        if (row < 0 || row >= 3 || col < 0 || col >= 3) {
+            throwMatrixIndexError();
+        }
+    }
+}
+
+// Default isSymmetric tolerance, relative to the largest coefficient
+template <typename T> inline constexpr T symmetryTolerance = T(1e-12);
+template <> inline constexpr float symmetryTolerance<float> = 1e-5f;
+
+// Matrices whose |determinant| is below this are treated as singular
+template <typename T> inline constexpr T singularDeterminant = T(1e-10);
+} // namespace detail
+
+template <typename T> struct SymmetricEigenDecompositionT;
+
+// 3x3 matrix over scalar type T. The library exports the float and double
+// instantiations (Matrix3x3f and Matrix3x3); other scalar types are not
+// provided. Conversions between precisions are explicit: Matrix3x3f(m) or
+// m.cast<float>().
+template <typename T>
+class Matrix3x3T {
 public:
-    Matrix3x3();
-    Matrix3x3(const Eigen::Matrix3d& eigen_mat);
-    Matrix3x3(const std::array<std::array<double, 3>, 3>& data);
+    using Scalar = T;
+    using EigenMatrix = Eigen::Matrix<T, 3, 3>;
+    using EigenVector = Eigen::Matrix<T, 3, 1>;
+
+    Matrix3x3T() : mat_(EigenMatrix::Zero()) {}
+    template <typename Derived>
+        requires std::same_as<typename Derived::Scalar, T>
+    Matrix3x3T(const Eigen::MatrixBase<Derived>& eigen_mat) : mat_(eigen_mat) {}
+    Matrix3x3T(const std::array<std::array<T, 3>, 3>& data);
+    
+    template <typename U>
+    explicit Matrix3x3T(const Matrix3x3T<U>& other) : mat_(other.eigen().template cast<T>()) {}
+    
+    // Evaluate a lazy expression in a single pass
+    template <typename Xpr>
+        requires std::same_as<typename Xpr::Scalar, T>
+    Matrix3x3T(const MatrixExpr<Xpr>& expr) : mat_(expr.eigen()) {}
     
     // Static constructors
-    static Matrix3x3 identity();
-    static Matrix3x3 zero();
-    static Matrix3x3 random();  // New: using Eigen's random
+    static Matrix3x3T identity() { return Matrix3x3T(EigenMatrix::Identity()); }
+    static Matrix3x3T zero() { return Matrix3x3T(EigenMatrix::Zero()); }
+    static Matrix3x3T random();  // New: using Eigen's random
     
-    // Element access
-    double& operator()(int row, int col);
-    const double& operator()(int row, int col) const;
+    // Element access; checked according to MATH_UTILS_BOUNDS_CHECK
+    template <bool Checked = MATH_UTILS_BOUNDS_CHECK != 0>
+    T& operator()(int row, int col) { detail::checkMatrixIndex<Checked>(row, col); return mat_(row, col); }
+    template <bool Checked = MATH_UTILS_BOUNDS_CHECK != 0>
+    const T& operator()(int row, int col) const { detail::checkMatrixIndex<Checked>(row, col); return mat_(row, col); }
+    
+    // Unchecked element access for tight loops
+    T& at_unchecked(int row, int col) { return mat_(row, col); }
+    const T& at_unchecked(int row, int col) const { return mat_(row, col); }
+    
+    // Raw column-major storage of the 9 coefficients
+    const T* data() const { return mat_.data(); }
+    T* data() { return mat_.data(); }
     
     // Get underlying Eigen matrix
-    const Eigen::Matrix3d& eigen() const { return mat_; }
-    Eigen::Matrix3d& eigen() { return mat_; }
+    const EigenMatrix& eigen() const { return mat_; }
+    EigenMatrix& eigen() { return mat_; }
     
-    // Matrix operations
-    Matrix3x3 operator+(const Matrix3x3& other) const;
-    Matrix3x3 operator-(const Matrix3x3& other) const;
-    Matrix3x3 operator*(const Matrix3x3& other) const;
-    Vector3 operator*(const Vector3& vec) const;
-    Matrix3x3 operator*(double scalar) const;
+    // Copy converted to another precision
+    template <typename U>
+    Matrix3x3T<U> cast() const { return Matrix3x3T<U>(*this); }
+    
+    // Matrix operations (+, -, and * with matrices, vectors and scalars) are
+    // the lazy free operators below
     
     // Utility functions
-    Matrix3x3 transpose() const;
-    double determinant() const;
-    Matrix3x3 inverse() const;
+    auto transpose() const& { return MatrixExpr(mat_.transpose()); }
+    Matrix3x3T transpose() && { return Matrix3x3T(EigenMatrix(mat_.transpose())); }
+    T determinant() const { return mat_.determinant(); }
+    Matrix3x3T inverse() const;
     
     // Eigen-specific operations
-    double trace() const;
-    double norm() const;
-    Eigen::Vector3d eigenvalues() const;
+    T trace() const { return mat_.trace(); }
+    T norm() const { return mat_.norm(); }
+    bool isSymmetric(T tolerance = detail::symmetryTolerance<T>) const;
+    
+    // Symmetric input takes the closed-form path and returns eigenvalues in
+    // ascending order; other input falls back to the general solver.
+    EigenVector eigenvalues() const;
     
-    // Output
-    friend std::ostream& operator<<(std::ostream& os, const Matrix3x3& m);
+    // Closed-form eigen decomposition; throws if the matrix is not symmetric
+    SymmetricEigenDecompositionT<T> symmetricEigen() const;
 
 private:
-    Eigen::Matrix3d mat_;
+    EigenMatrix mat_;
+};
+
+using Matrix3x3 = Matrix3x3T<double>;
+using Matrix3x3f = Matrix3x3T<float>;
+
+template <typename Xpr>
+Matrix3x3T<typename MatrixExpr<Xpr>::Scalar> MatrixExpr<Xpr>::eval() const {
+    return Matrix3x3T<Scalar>(*this);
+}
+
+// Output; prints a Matrix3x3: or Matrix3x3f: header and one row per line
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const Matrix3x3T<T>& m);
+
+extern template std::ostream& operator<<(std::ostream& os, const Matrix3x3T<float>& m);
+extern template std::ostream& operator<<(std::ostream& os, const Matrix3x3T<double>& m);
+
+// Lazy matrix arithmetic
+template <MatrixOperand L, MatrixOperand R>
+    requires SameScalar<L, R>
+auto operator+(L&& lhs, R&& rhs) {
+    return detail::evalIfTemporary<L, R>(MatrixExpr(lhs.eigen() + rhs.eigen()));
+}
+
+template <MatrixOperand L, MatrixOperand R>
+    requires SameScalar<L, R>
+auto operator-(L&& lhs, R&& rhs) {
+    return detail::evalIfTemporary<L, R>(MatrixExpr(lhs.eigen() - rhs.eigen()));
+}
+
+template <MatrixOperand M>
+auto operator-(M&& mat) {
+    return detail::evalIfTemporary<M>(MatrixExpr(-mat.eigen()));
+}
+
+template <MatrixOperand L, MatrixOperand R>
+    requires SameScalar<L, R>
+auto operator*(L&& lhs, R&& rhs) {
+    return detail::evalIfTemporary<L, R>(MatrixExpr(lhs.eigen() * rhs.eigen()));
+}
+
+template <MatrixOperand M, VectorOperand V>
+    requires SameScalar<M, V>
+auto operator*(M&& mat, V&& vec) {
+    return detail::evalIfTemporary<M, V>(VectorExpr(mat.eigen() * vec.eigen()));
+}
+
+template <MatrixOperand M>
+auto operator*(M&& mat, operand_scalar_t<M> scalar) {
+    return detail::evalIfTemporary<M>(MatrixExpr(mat.eigen() * scalar));
+}
+
+template <MatrixOperand M>
+auto operator*(operand_scalar_t<M> scalar, M&& mat) {
+    return detail::evalIfTemporary<M>(MatrixExpr(scalar * mat.eigen()));
+}
+
+template <typename Xpr>
+std::ostream& operator<<(std::ostream& os, const MatrixExpr<Xpr>& expr) {
+    return os << expr.eval();
+}
+
+// Eigenvalues in ascending order with the matching unit eigenvectors stored
+// as the columns of `eigenvectors`.
+template <typename T>
+struct SymmetricEigenDecompositionT {
+    Eigen::Matrix<T, 3, 1> eigenvalues;
+    Matrix3x3T<T> eigenvectors;
 };
 
+using SymmetricEigenDecomposition = SymmetricEigenDecompositionT<double>;
+using SymmetricEigenDecompositionf = SymmetricEigenDecompositionT<float>;
+
+// Only the out-of-line members are instantiated in the library; the inline
+// ones are instantiated by each caller.
+extern template Matrix3x3T<float>::Matrix3x3T(const std::array<std::array<float, 3>, 3>& data);
+extern template Matrix3x3T<float> Matrix3x3T<float>::random();
+extern template Matrix3x3T<float> Matrix3x3T<float>::inverse() const;
+extern template bool Matrix3x3T<float>::isSymmetric(float tolerance) const;
+extern template Matrix3x3T<float>::EigenVector Matrix3x3T<float>::eigenvalues() const;
+extern template SymmetricEigenDecompositionT<float> Matrix3x3T<float>::symmetricEigen() const;
+
+extern template Matrix3x3T<double>::Matrix3x3T(const std::array<std::array<double, 3>, 3>& data);
+extern template Matrix3x3T<double> Matrix3x3T<double>::random();
+extern template Matrix3x3T<double> Matrix3x3T<double>::inverse() const;
+extern template bool Matrix3x3T<double>::isSymmetric(double tolerance) const;
+extern template Matrix3x3T<double>::EigenVector Matrix3x3T<double>::eigenvalues() const;
+extern template SymmetricEigenDecompositionT<double> Matrix3x3T<double>::symmetricEigen() const;
+
+// Decompose many symmetric matrices; `out` must be the same size as
+// `matrices`. Throws std::invalid_argument, naming the first offending index,
+// before writing any output if some matrix is not symmetric.
+void symmetricEigenBatch(std::span<const Matrix3x3> matrices, std::span<SymmetricEigenDecomposition> out);
+void symmetricEigenBatch(std::span<const Matrix3x3f> matrices, std::span<SymmetricEigenDecompositionf> out);
+
 } // namespace math_utils
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "matrix.hpp"
+#include "thread_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace math_utils {
+
+// Per-matrix outcome of inverseBatch
+enum class InverseStatus : std::uint8_t {
+    Ok = 0,
+    Singular = 1  // |determinant| below the Matrix3x3::inverse() threshold; output set to zero
+};
+
+// Determinants and inverses of large arrays of matrices, split across `pool`.
+// Each determinant is computed once, from the same cofactors as the inverse,
+// and singular matrices are flagged in `status` instead of throwing, so one
+// bad entry does not abort the batch. Output spans must be the same size as
+// `matrices` (std::invalid_argument otherwise); `out` may be the input array.
+// inverseBatch returns the number of singular matrices.
+void determinantBatch(std::span<const Matrix3x3> matrices, std::span<double> out,
+                      ThreadPool& pool = ThreadPool::global());
+void determinantBatch(std::span<const Matrix3x3f> matrices, std::span<float> out,
+                      ThreadPool& pool = ThreadPool::global());
+
+std::size_t inverseBatch(std::span<const Matrix3x3> matrices, std::span<Matrix3x3> out,
+                         std::span<InverseStatus> status, ThreadPool& pool = ThreadPool::global());
+std::size_t inverseBatch(std::span<const Matrix3x3f> matrices, std::span<Matrix3x3f> out,
+                         std::span<InverseStatus> status, ThreadPool& pool = ThreadPool::global());
+
+// Also stores each determinant
+std::size_t inverseBatch(std::span<const Matrix3x3> matrices, std::span<Matrix3x3> out,
+                         std::span<InverseStatus> status, std::span<double> determinants,
+                         ThreadPool& pool = ThreadPool::global());
+std::size_t inverseBatch(std::span<const Matrix3x3f> matrices, std::span<Matrix3x3f> out,
+                         std::span<InverseStatus> status, std::span<float> determinants,
+                         ThreadPool& pool = ThreadPool::global());
+
+} // namespace math_utils
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "vector_batch.hpp"
+#include <Eigen/Geometry>
+#include <cmath>
+#include <span>
+
+namespace math_utils {
+
+// 3D rotation stored as a unit quaternion. Composing two rotations takes 16
+// multiplies for the Hamilton product plus a first-order renormalization
+// (5 more, no square root), so long chains stay unit length to rounding
+// instead of drifting the way chained Matrix3x3 products drift from
+// orthonormal. The library exports the float and double instantiations
+// (Rotationf and Rotation); conversions between them are explicit.
+template <typename T>
+class RotationT {
+public:
+    using Scalar = T;
+    using EigenQuaternion = Eigen::Quaternion<T>;
+
+    RotationT() : q_(EigenQuaternion::Identity()) {}
+
+    // Normalizes `q`; throws std::invalid_argument for a zero quaternion
+    explicit RotationT(const EigenQuaternion& q);
+
+    template <typename U>
+    explicit RotationT(const RotationT<U>& other) : q_(other.eigen().template cast<T>()) {}
+
+    static RotationT identity() { return RotationT(); }
+    static RotationT fromQuaternion(T w, T x, T y, T z) { return RotationT(EigenQuaternion(w, x, y, z)); }
+
+    // Right-handed rotation by `angle` radians about `axis`, which need not
+    // be unit length; throws std::runtime_error for a zero axis
+    static RotationT fromAxisAngle(const Vector3T<T>& axis, T angle);
+
+    // Rotation of a (near-)orthonormal matrix with determinant +1. Small
+    // drift from orthonormal is absorbed by renormalizing the quaternion;
+    // throws std::invalid_argument if the determinant is not positive.
+    static RotationT fromMatrix(const Matrix3x3T<T>& matrix);
+    Matrix3x3T<T> toMatrix() const { return Matrix3x3T<T>(q_.toRotationMatrix()); }
+
+    // Components of the unit quaternion
+    T w() const { return q_.w(); }
+    T x() const { return q_.x(); }
+    T y() const { return q_.y(); }
+    T z() const { return q_.z(); }
+    const EigenQuaternion& eigen() const { return q_; }
+
+    // Copy converted to another precision
+    template <typename U>
+    RotationT<U> cast() const { return RotationT<U>(*this); }
+
+    // (a * b).apply(p) == a.apply(b.apply(p))
+    RotationT operator*(const RotationT& other) const { return fromProduct(q_ * other.q_); }
+    RotationT inverse() const { return fromUnit(q_.conjugate()); }
+
+    Vector3T<T> apply(const Vector3T<T>& point) const { return Vector3T<T>(q_ * point.eigen()); }
+    Vector3T<T> operator*(const Vector3T<T>& point) const { return apply(point); }
+
+    // Rotation angle in [0, pi] and the smallest angle between two rotations
+    T angle() const { return T(2) * std::atan2(q_.vec().norm(), std::abs(q_.w())); }
+    T angularDistance(const RotationT& other) const { return q_.angularDistance(other.q_); }
+
+private:
+    struct Unit {};
+    RotationT(const EigenQuaternion& q, Unit) : q_(q) {}
+    static RotationT fromUnit(const EigenQuaternion& q) { return RotationT(q, Unit{}); }
+
+    // The product of unit quaternions is unit up to rounding; one Newton
+    // step of 1/sqrt(n) around n = 1 removes that error without a sqrt
+    static RotationT fromProduct(const EigenQuaternion& q) {
+        const T scale = (T(3) - q.squaredNorm()) * T(0.5);
+        return fromUnit(EigenQuaternion(q.coeffs() * scale));
+    }
+
+    EigenQuaternion q_;
+};
+
+// Rotation followed by translation: apply(p) = rotation * p + translation
+template <typename T>
+class RigidTransformT {
+public:
+    using Scalar = T;
+
+    RigidTransformT() = default;
+    RigidTransformT(const RotationT<T>& rotation, const Vector3T<T>& translation = Vector3T<T>())
+        : rotation_(rotation), translation_(translation) {}
+
+    template <typename U>
+    explicit RigidTransformT(const RigidTransformT<U>& other)
+        : rotation_(other.rotation()), translation_(other.translation()) {}
+
+    static RigidTransformT identity() { return RigidTransformT(); }
+
+    // See RotationT::fromMatrix
+    static RigidTransformT fromMatrix(const Matrix3x3T<T>& matrix, const Vector3T<T>& translation = Vector3T<T>()) {
+        return RigidTransformT(RotationT<T>::fromMatrix(matrix), translation);
+    }
+
+    const RotationT<T>& rotation() const { return rotation_; }
+    const Vector3T<T>& translation() const { return translation_; }
+
+    template <typename U>
+    RigidTransformT<U> cast() const { return RigidTransformT<U>(*this); }
+
+    // (a * b).apply(p) == a.apply(b.apply(p))
+    RigidTransformT operator*(const RigidTransformT& other) const {
+        return RigidTransformT(rotation_ * other.rotation_, rotation_.apply(other.translation_) + translation_);
+    }
+    RigidTransformT inverse() const {
+        const RotationT<T> inv = rotation_.inverse();
+        return RigidTransformT(inv, -inv.apply(translation_));
+    }
+
+    Vector3T<T> apply(const Vector3T<T>& point) const { return rotation_.apply(point) + translation_; }
+    Vector3T<T> operator*(const Vector3T<T>& point) const { return apply(point); }
+
+private:
+    RotationT<T> rotation_;
+    Vector3T<T> translation_;
+};
+
+using Rotation = RotationT<double>;
+using Rotationf = RotationT<float>;
+using RigidTransform = RigidTransformT<double>;
+using RigidTransformf = RigidTransformT<float>;
+
+extern template class RotationT<float>;
+extern template class RotationT<double>;
+extern template class RigidTransformT<float>;
+extern template class RigidTransformT<double>;
+
+// Apply a rigid transform (or, through the implicit conversion, a rotation)
+// to a whole point array. The quaternion is expanded to a matrix once and
+// the points go through the same kernels as transformPoints(Matrix3x3, ...)
+// in transform.hpp. `in` and `out` must have the same size and may refer to
+// the same memory.
+void transformPoints(const RigidTransform& transform, std::span<const Vector3> in, std::span<Vector3> out);
+void transformPointsInPlace(const RigidTransform& transform, std::span<Vector3> points);
+void transformPoints(const RigidTransform& transform, const Vector3Batch& in, Vector3Batch& out);
+void transformPointsInPlace(const RigidTransform& transform, Vector3Batch& points);
+void transformPoints(const RigidTransformf& transform, std::span<const Vector3f> in, std::span<Vector3f> out);
+void transformPointsInPlace(const RigidTransformf& transform, std::span<Vector3f> points);
+
+} // namespace math_utils
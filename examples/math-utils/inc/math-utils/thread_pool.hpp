@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace math_utils {
+
+// Fixed set of worker threads for data-parallel loops over index ranges.
+//
+// parallelFor splits [0, count) into one contiguous section per thread
+// (the calling thread included). Each thread claims grain-sized chunks from
+// the front of its own section and, once that is exhausted, steals chunks
+// from the other sections, so uneven chunks or a descheduled thread do not
+// leave the rest idle. Claiming a chunk is a single atomic fetch_add.
+class ThreadPool {
+public:
+    // 0 uses std::thread::hardware_concurrency(); the calling thread counts
+    // as one, so ThreadPool(1) runs everything inline
+    explicit ThreadPool(std::size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Threads that take part in parallelFor, including the caller
+    std::size_t size() const { return workers_.size() + 1; }
+
+    // Calls body(begin, end) over chunks of at most `grain` indices covering
+    // [0, count) and blocks until all chunks ran. The first exception thrown
+    // by body cancels the remaining chunks and is rethrown here. Calls from
+    // inside a body run inline; calls from several threads take turns.
+    void parallelFor(std::size_t count, std::size_t grain,
+                     const std::function<void(std::size_t, std::size_t)>& body);
+
+    // Process-wide pool sized to the hardware, created on first use
+    static ThreadPool& global();
+
+private:
+    struct Job;
+
+    void workerLoop(std::size_t index);
+    static void runJob(Job& job, std::size_t index);
+
+    std::vector<std::thread> workers_;
+
+    // Serializes parallelFor calls from different threads
+    std::mutex submitMutex_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    Job* job_ = nullptr;
+    std::uint64_t generation_ = 0;
+    std::size_t running_ = 0;
+    bool stop_ = false;
+};
+
+} // namespace math_utils
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "vector_batch.hpp"
+#include <span>
+
+namespace math_utils {
+
+// Instruction set used by the batched transform kernels. The best level the
+// CPU supports is selected at runtime on first use.
+enum class SimdLevel {
+    Scalar,
+    AVX2,
+    AVX512
+};
+
+SimdLevel simdLevel();
+bool simdLevelSupported(SimdLevel level);
+void setSimdLevel(SimdLevel level);  // Throws if the CPU lacks the level
+const char* simdLevelName(SimdLevel level);
+
+// Compute out[i] = matrix * in[i] + translation for a whole point cloud.
+// `in` and `out` must have the same size; they may refer to the same memory.
+// No memory is allocated per point.
+void transformPoints(const Matrix3x3& matrix, std::span<const Vector3> in, std::span<Vector3> out,
+                     const Vector3& translation = Vector3());
+void transformPointsInPlace(const Matrix3x3& matrix, std::span<Vector3> points,
+                            const Vector3& translation = Vector3());
+
+// Structure-of-arrays variants; `out` is resized to match `in`.
+void transformPoints(const Matrix3x3& matrix, const Vector3Batch& in, Vector3Batch& out,
+                     const Vector3& translation = Vector3());
+void transformPointsInPlace(const Matrix3x3& matrix, Vector3Batch& points,
+                            const Vector3& translation = Vector3());
+
+} // namespace math_utils
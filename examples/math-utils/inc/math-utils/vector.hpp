@@ -1,44 +1,145 @@
 #pragma once
 
+#include "expression.hpp"
 #include <Eigen/Dense>
+#include <concepts>
 #include <iostream>
 
 namespace math_utils {
 
-class Vector3 {
+namespace detail {
+// Error paths stay out of line so the inlined hot path carries no
+// exception-construction code.
+[[noreturn]] void throwZeroVectorError();
+} // namespace detail
+
+// 3D vector over scalar type T. Vector3T is defined entirely in this header;
+// the library provides stream output for the float and double
+// instantiations (Vector3f and Vector3) only.
+//
+// Conversions between precisions are explicit: Vector3f(v) or v.cast<float>().
+// dot, magnitude and squaredNorm accumulate in T by default; pass a wider
+// type, e.g. v.dot<double>(w) on Vector3f, to accumulate in higher precision.
+template <typename T>
+class Vector3T {
 public:
-    Vector3(double x = 0.0, double y = 0.0, double z = 0.0);
-    Vector3(const Eigen::Vector3d& eigen_vec);
-    
+    using Scalar = T;
+    using EigenVector = Eigen::Matrix<T, 3, 1>;
+
+    Vector3T(T x = T(0), T y = T(0), T z = T(0)) : vec_(x, y, z) {}
+    Vector3T(const EigenVector& eigen_vec) : vec_(eigen_vec) {}
+
+    template <typename U>
+    explicit Vector3T(const Vector3T<U>& other) : vec_(other.eigen().template cast<T>()) {}
+
+    // Evaluate a lazy expression in a single pass
+    template <typename Xpr>
+        requires std::same_as<typename Xpr::Scalar, T>
+    Vector3T(const VectorExpr<Xpr>& expr) : vec_(expr.eigen()) {}
+
     // Getters
-    double x() const { return vec_(0); }
-    double y() const { return vec_(1); }
-    double z() const { return vec_(2); }
-    
+    T x() const { return vec_(0); }
+    T y() const { return vec_(1); }
+    T z() const { return vec_(2); }
+
     // Get underlying Eigen vector
-    const Eigen::Vector3d& eigen() const { return vec_; }
-    Eigen::Vector3d& eigen() { return vec_; }
-    
-    // Basic operations
-    Vector3 operator+(const Vector3& other) const;
-    Vector3 operator-(const Vector3& other) const;
-    Vector3 operator*(double scalar) const;
-    
+    const EigenVector& eigen() const { return vec_; }
+    EigenVector& eigen() { return vec_; }
+
+    // Raw storage: x, y, z contiguous
+    const T* data() const { return vec_.data(); }
+    T* data() { return vec_.data(); }
+
+    // Copy converted to another precision
+    template <typename U>
+    Vector3T<U> cast() const { return Vector3T<U>(*this); }
+
+    // Basic operations (+, -, scalar * and /) are the lazy free operators below
+
     // Utility functions
-    double magnitude() const;
-    Vector3 normalized() const;
-    double dot(const Vector3& other) const;
-    Vector3 cross(const Vector3& other) const;
-    
+    template <std::floating_point Acc = T>
+    Acc magnitude() const { return vec_.template cast<Acc>().norm(); }
+    Vector3T normalized() const;
+    template <std::floating_point Acc = T>
+    Acc dot(const Vector3T& other) const { return vec_.template cast<Acc>().dot(other.vec_.template cast<Acc>()); }
+    Vector3T cross(const Vector3T& other) const { return Vector3T(vec_.cross(other.vec_)); }
+
     // Eigen-specific operations
-    double squaredNorm() const;
-    Vector3 cwiseProduct(const Vector3& other) const;  // Component-wise multiplication
-    
-    // Output
-    friend std::ostream& operator<<(std::ostream& os, const Vector3& v);
+    template <std::floating_point Acc = T>
+    Acc squaredNorm() const { return vec_.template cast<Acc>().squaredNorm(); }
+    template <VectorOperand R>
+        requires SameScalar<Vector3T, R>
+    auto cwiseProduct(R&& other) const& {  // Component-wise multiplication
+        return detail::evalIfTemporary<R>(VectorExpr(vec_.cwiseProduct(other.eigen())));
+    }
+    template <VectorOperand R>
+        requires SameScalar<Vector3T, R>
+    Vector3T cwiseProduct(const R& other) && { return Vector3T(EigenVector(vec_.cwiseProduct(other.eigen()))); }
 
 private:
-    Eigen::Vector3d vec_;
+    EigenVector vec_;
 };
 
+using Vector3 = Vector3T<double>;
+using Vector3f = Vector3T<float>;
+
+template <typename T>
+inline Vector3T<T> Vector3T<T>::normalized() const {
+    const T norm = vec_.norm();
+    if (norm == T(0)) {
+        detail::throwZeroVectorError();
+    }
+    return Vector3T(vec_ / norm);
+}
+
+template <typename Xpr>
+Vector3T<typename VectorExpr<Xpr>::Scalar> VectorExpr<Xpr>::eval() const {
+    return Vector3T<Scalar>(*this);
+}
+
+// Output; prints Vector3(...) or Vector3f(...)
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const Vector3T<T>& v);
+
+extern template std::ostream& operator<<(std::ostream& os, const Vector3T<float>& v);
+extern template std::ostream& operator<<(std::ostream& os, const Vector3T<double>& v);
+
+// Lazy vector arithmetic
+template <VectorOperand L, VectorOperand R>
+    requires SameScalar<L, R>
+auto operator+(L&& lhs, R&& rhs) {
+    return detail::evalIfTemporary<L, R>(VectorExpr(lhs.eigen() + rhs.eigen()));
+}
+
+template <VectorOperand L, VectorOperand R>
+    requires SameScalar<L, R>
+auto operator-(L&& lhs, R&& rhs) {
+    return detail::evalIfTemporary<L, R>(VectorExpr(lhs.eigen() - rhs.eigen()));
+}
+
+template <VectorOperand V>
+auto operator-(V&& vec) {
+    return detail::evalIfTemporary<V>(VectorExpr(-vec.eigen()));
+}
+
+template <VectorOperand V>
+auto operator*(V&& vec, operand_scalar_t<V> scalar) {
+    return detail::evalIfTemporary<V>(VectorExpr(vec.eigen() * scalar));
+}
+
+template <VectorOperand V>
+auto operator*(operand_scalar_t<V> scalar, V&& vec) {
+    return detail::evalIfTemporary<V>(VectorExpr(scalar * vec.eigen()));
+}
+
+template <VectorOperand V>
+auto operator/(V&& vec, operand_scalar_t<V> scalar) {
+    return detail::evalIfTemporary<V>(VectorExpr(vec.eigen() / scalar));
+}
+
+template <typename Xpr>
+std::ostream& operator<<(std::ostream& os, const VectorExpr<Xpr>& expr) {
+    return os << expr.eval();
+}
+
 } // namespace math_utils
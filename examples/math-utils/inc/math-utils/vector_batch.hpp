@@ -0,0 +1,72 @@
+#pragma once
+
+#include "vector.hpp"
+#include <Eigen/Dense>
+#include <cstddef>
+#include <vector>
+
+namespace math_utils {
+
+// Structure-of-arrays container for many Vector3 values. The x, y and z
+// components live in separate aligned Eigen arrays so bulk operations run as
+// vectorized loops over contiguous memory.
+//
+// The single-operation element-wise results (+, -, scalar * and
+// cwiseProduct) equal the matching Vector3 operation exactly. The others sum
+// several products, which the batch loops and the caller's inlined Vector3
+// code may order or fuse into FMAs differently. With eps the machine epsilon,
+// they differ from Vector3 by at most:
+//   dot              4 eps * sum of |a_i * b_i|
+//   cross            4 eps * (|a_y * b_z| + |a_z * b_y|) for x, likewise y, z
+//   squaredNorm      4 eps * |result|, and the same for magnitude
+//   normalized       4 eps per component
+// dot and cross can therefore differ by much more than 4 ulps of the result
+// when their terms nearly cancel.
+class Vector3Batch {
+public:
+    Vector3Batch() = default;
+    explicit Vector3Batch(std::size_t size);
+    explicit Vector3Batch(const std::vector<Vector3>& vectors);
+    Vector3Batch(Eigen::ArrayXd xs, Eigen::ArrayXd ys, Eigen::ArrayXd zs);
+
+    // Size and element access
+    std::size_t size() const { return static_cast<std::size_t>(x_.size()); }
+    bool empty() const { return x_.size() == 0; }
+    Vector3 operator[](std::size_t index) const;
+    void set(std::size_t index, const Vector3& vec);
+    std::vector<Vector3> toVectors() const;
+
+    // Component arrays
+    const Eigen::ArrayXd& xs() const { return x_; }
+    const Eigen::ArrayXd& ys() const { return y_; }
+    const Eigen::ArrayXd& zs() const { return z_; }
+    Eigen::ArrayXd& xs() { return x_; }
+    Eigen::ArrayXd& ys() { return y_; }
+    Eigen::ArrayXd& zs() { return z_; }
+
+    // Bulk operations
+    Vector3Batch operator+(const Vector3Batch& other) const;
+    Vector3Batch operator-(const Vector3Batch& other) const;
+    Vector3Batch operator*(double scalar) const;
+
+    // Broadcast a single vector over the batch
+    Vector3Batch operator+(const Vector3& vec) const;
+    Vector3Batch operator-(const Vector3& vec) const;
+
+    // Per-element utility functions
+    Eigen::ArrayXd magnitude() const;
+    Eigen::ArrayXd squaredNorm() const;
+    Vector3Batch normalized() const;
+    Eigen::ArrayXd dot(const Vector3Batch& other) const;
+    Vector3Batch cross(const Vector3Batch& other) const;
+    Vector3Batch cwiseProduct(const Vector3Batch& other) const;
+
+private:
+    void checkSameSize(const Vector3Batch& other) const;
+
+    Eigen::ArrayXd x_;
+    Eigen::ArrayXd y_;
+    Eigen::ArrayXd z_;
+};
+
+} // namespace math_utils
@@ -0,0 +1,336 @@
+#include "math-utils/batch_file.hpp"
+#include "math-utils/thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace math_utils {
+
+namespace {
+
+// Elements per parallelFor chunk within one pipeline chunk
+constexpr std::size_t kGrain = 2048;
+
+[[noreturn]] void throwSystemError(const std::string& what) {
+    throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+// Closes the descriptor on scope exit unless it is stdout
+class FileDescriptor {
+public:
+    explicit FileDescriptor(int fd) : fd_(fd) {}
+    ~FileDescriptor() {
+        if (fd_ > STDOUT_FILENO) {
+            ::close(fd_);
+        }
+    }
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    int get() const { return fd_; }
+
+private:
+    int fd_;
+};
+
+int openOutput(const std::string& path) {
+    if (path == "-") {
+        return STDOUT_FILENO;
+    }
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throwSystemError("Failed to open batch output " + path);
+    }
+    return fd;
+}
+
+void writeAll(int fd, const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        const ssize_t written = ::write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwSystemError("Failed to write batch output");
+        }
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+const char* opName(BatchOp op) {
+    switch (op) {
+        case BatchOp::Transform: return "transform";
+        case BatchOp::Normalize: return "normalize";
+        case BatchOp::Determinant: return "determinant";
+        case BatchOp::Eigenvalues: return "eigenvalues";
+    }
+    return "unknown";
+}
+
+// Element width each step takes and produces
+int inputWidth(BatchOp op) {
+    return op == BatchOp::Transform || op == BatchOp::Normalize ? 3 : 9;
+}
+
+int outputWidth(BatchOp op) {
+    return op == BatchOp::Determinant ? 1 : 3;
+}
+
+BatchFileHeader readHeader(std::span<const std::byte> bytes) {
+    BatchFileHeader header;
+    if (bytes.size() < sizeof(header)) {
+        throw std::invalid_argument("Batch input is smaller than its header");
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (std::memcmp(header.magic, BatchFileHeader{}.magic, sizeof(header.magic)) != 0) {
+        throw std::invalid_argument("Batch input has no MUB1 header");
+    }
+    if (header.width != 1 && header.width != 3 && header.width != 9) {
+        throw std::invalid_argument("Batch input has unsupported element width " + std::to_string(header.width));
+    }
+    if (header.scalarSize != sizeof(float) && header.scalarSize != sizeof(double)) {
+        throw std::invalid_argument("Batch input has unsupported scalar size " + std::to_string(header.scalarSize));
+    }
+    const std::uint64_t available = (bytes.size() - sizeof(header)) / (header.width * header.scalarSize);
+    if (header.count > available) {
+        throw std::invalid_argument("Batch input is truncated: header declares " + std::to_string(header.count) +
+                                    " elements, file holds " + std::to_string(available));
+    }
+    return header;
+}
+
+// Applies one step to `n` elements; `in` and `out` do not overlap
+template <typename T>
+void applyStep(const BatchStep& step, const T* in, T* out, std::size_t n, std::atomic<std::uint64_t>& zeroVectors) {
+    using Points = Eigen::Matrix<T, 3, Eigen::Dynamic>;
+    const Eigen::Matrix<T, 3, 3> matrix = step.matrix.eigen().template cast<T>();
+    const Eigen::Matrix<T, 3, 1> translation = step.translation.eigen().template cast<T>();
+
+    ThreadPool::global().parallelFor(n, kGrain, [&](std::size_t begin, std::size_t end) {
+        const std::size_t count = end - begin;
+        switch (step.op) {
+            case BatchOp::Transform: {
+                Eigen::Map<const Points> src(in + 3 * begin, 3, count);
+                Eigen::Map<Points> dst(out + 3 * begin, 3, count);
+                dst.noalias() = (matrix * src).colwise() + translation;
+                break;
+            }
+            case BatchOp::Normalize: {
+                std::uint64_t zeros = 0;
+                for (std::size_t i = begin; i < end; ++i) {
+                    Eigen::Map<const Eigen::Matrix<T, 3, 1>> v(in + 3 * i);
+                    Eigen::Map<Eigen::Matrix<T, 3, 1>> r(out + 3 * i);
+                    const T norm = v.norm();
+                    if (norm == T(0)) {
+                        r.setZero();
+                        ++zeros;
+                    } else {
+                        r = v / norm;
+                    }
+                }
+                zeroVectors.fetch_add(zeros, std::memory_order_relaxed);
+                break;
+            }
+            case BatchOp::Determinant:
+                for (std::size_t i = begin; i < end; ++i) {
+                    out[i] = Eigen::Map<const Eigen::Matrix<T, 3, 3>>(in + 9 * i).determinant();
+                }
+                break;
+            case BatchOp::Eigenvalues:
+                for (std::size_t i = begin; i < end; ++i) {
+                    const Matrix3x3T<T> m(Eigen::Map<const Eigen::Matrix<T, 3, 3>>(in + 9 * i));
+                    Eigen::Map<Eigen::Matrix<T, 3, 1>>(out + 3 * i) = m.eigenvalues();
+                }
+                break;
+        }
+    });
+}
+
+template <typename T>
+BatchResult runTyped(const BatchFileHeader& header, const std::byte* data, int fd,
+                     std::span<const BatchStep> steps, std::size_t chunkElements) {
+    BatchResult result;
+    result.count = header.count;
+    result.width = steps.empty() ? header.width : static_cast<std::uint8_t>(outputWidth(steps.back().op));
+
+    BatchFileHeader outHeader = header;
+    outHeader.width = result.width;
+    writeAll(fd, &outHeader, sizeof(outHeader));
+    result.bytesWritten = sizeof(outHeader);
+
+    // The mapping is page aligned and the header is 16 bytes, so the
+    // elements are aligned for T
+    const T* elements = reinterpret_cast<const T*>(data + sizeof(BatchFileHeader));
+    // Steps produce at most 3 scalars per element
+    std::vector<T> ping(steps.empty() ? 0 : chunkElements * 3);
+    std::vector<T> pong(steps.size() < 2 ? 0 : chunkElements * 3);
+    std::atomic<std::uint64_t> zeroVectors{0};
+
+    for (std::uint64_t start = 0; start < header.count; start += chunkElements) {
+        const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(chunkElements, header.count - start));
+        const T* current = elements + start * header.width;
+        for (std::size_t s = 0; s < steps.size(); ++s) {
+            T* next = s % 2 == 0 ? ping.data() : pong.data();
+            applyStep(steps[s], current, next, n, zeroVectors);
+            current = next;
+        }
+        const std::size_t bytes = n * result.width * sizeof(T);
+        writeAll(fd, current, bytes);
+        result.bytesWritten += bytes;
+    }
+    result.zeroVectors = zeroVectors.load(std::memory_order_relaxed);
+    return result;
+}
+
+template <typename Element>
+void writeElements(const std::string& path, std::span<const Element> elements, std::uint8_t width) {
+    using Scalar = typename Element::Scalar;
+    static_assert(sizeof(Element) == sizeof(Scalar) * (std::is_same_v<Element, Vector3T<Scalar>> ? 3 : 9));
+
+    BatchFileHeader header;
+    header.width = width;
+    header.scalarSize = sizeof(Scalar);
+    header.count = elements.size();
+
+    FileDescriptor fd(openOutput(path));
+    writeAll(fd.get(), &header, sizeof(header));
+    writeAll(fd.get(), elements.data(), elements.size_bytes());
+}
+
+} // namespace
+
+MappedFile::MappedFile(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throwSystemError("Failed to open " + path);
+    }
+    FileDescriptor guard(fd);
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        throwSystemError("Failed to stat " + path);
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ == 0) {
+        return;
+    }
+    void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        throwSystemError("Failed to map " + path);
+    }
+    ::posix_madvise(mapping, size_, POSIX_MADV_SEQUENTIAL);
+    data_ = static_cast<const std::byte*>(mapping);
+}
+
+MappedFile::~MappedFile() {
+    if (data_) {
+        ::munmap(const_cast<std::byte*>(data_), size_);
+    }
+}
+
+BatchStep parseBatchStep(std::string_view spec) {
+    BatchStep step;
+    if (spec == "normalize") {
+        step.op = BatchOp::Normalize;
+        return step;
+    }
+    if (spec == "determinant") {
+        step.op = BatchOp::Determinant;
+        return step;
+    }
+    if (spec == "eigenvalues") {
+        step.op = BatchOp::Eigenvalues;
+        return step;
+    }
+
+    constexpr std::string_view prefix = "transform:";
+    if (!spec.starts_with(prefix)) {
+        throw std::invalid_argument("Unknown batch operation: " + std::string(spec));
+    }
+    std::vector<double> values;
+    std::string_view rest = spec.substr(prefix.size());
+    while (!rest.empty()) {
+        const std::size_t comma = std::min(rest.find(','), rest.size());
+        const std::string_view field = rest.substr(0, comma);
+        double value = 0.0;
+        const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+        if (error != std::errc() || end != field.data() + field.size()) {
+            throw std::invalid_argument("Invalid number in batch operation: " + std::string(spec));
+        }
+        values.push_back(value);
+        rest.remove_prefix(std::min(comma + 1, rest.size()));
+    }
+    if (values.size() != 9 && values.size() != 12) {
+        throw std::invalid_argument("transform takes 9 matrix coefficients and an optional translation: " +
+                                    std::string(spec));
+    }
+
+    step.op = BatchOp::Transform;
+    for (int i = 0; i < 9; ++i) {
+        step.matrix.at_unchecked(i / 3, i % 3) = values[static_cast<std::size_t>(i)];
+    }
+    if (values.size() == 12) {
+        step.translation = Vector3(values[9], values[10], values[11]);
+    }
+    return step;
+}
+
+BatchResult runBatch(const std::string& input, const std::string& output,
+                     std::span<const BatchStep> steps, std::size_t chunkElements) {
+    if (chunkElements == 0) {
+        throw std::invalid_argument("Batch chunk size must be positive");
+    }
+    // Truncating the output would pull the pages out from under the mapping
+    struct stat inputInfo, outputInfo;
+    if (output != "-" && ::stat(input.c_str(), &inputInfo) == 0 && ::stat(output.c_str(), &outputInfo) == 0 &&
+        inputInfo.st_dev == outputInfo.st_dev && inputInfo.st_ino == outputInfo.st_ino) {
+        throw std::invalid_argument("Batch output would overwrite its input: " + output);
+    }
+
+    const MappedFile mapping(input);
+    const BatchFileHeader header = readHeader(mapping.bytes());
+
+    int width = header.width;
+    for (const BatchStep& step : steps) {
+        if (inputWidth(step.op) != width) {
+            throw std::invalid_argument(std::string(opName(step.op)) + " does not accept elements of width " +
+                                        std::to_string(width));
+        }
+        width = outputWidth(step.op);
+    }
+
+    FileDescriptor fd(openOutput(output));
+    if (header.scalarSize == sizeof(float)) {
+        return runTyped<float>(header, mapping.bytes().data(), fd.get(), steps, chunkElements);
+    }
+    return runTyped<double>(header, mapping.bytes().data(), fd.get(), steps, chunkElements);
+}
+
+void writeBatchFile(const std::string& path, std::span<const Vector3> vectors) {
+    writeElements(path, vectors, 3);
+}
+
+void writeBatchFile(const std::string& path, std::span<const Vector3f> vectors) {
+    writeElements(path, vectors, 3);
+}
+
+void writeBatchFile(const std::string& path, std::span<const Matrix3x3> matrices) {
+    writeElements(path, matrices, 9);
+}
+
+void writeBatchFile(const std::string& path, std::span<const Matrix3x3f> matrices) {
+    writeElements(path, matrices, 9);
+}
+
+} // namespace math_utils
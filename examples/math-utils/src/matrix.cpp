@@ -1,14 +1,23 @@
 #include "math-utils/matrix.hpp"
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 #include <iomanip>
+#include <string>
+#include <type_traits>
 
 namespace math_utils {
 
-Matrix3x3::Matrix3x3() : mat_(Eigen::Matrix3d::Zero()) {}
+namespace detail {
 
-Matrix3x3::Matrix3x3(const Eigen::Matrix3d& eigen_mat) : mat_(eigen_mat) {}
+void throwMatrixIndexError() {
+    throw std::out_of_range("Matrix index out of range");
+}
+
+} // namespace detail
 
-Matrix3x3::Matrix3x3(const std::array<std::array<double, 3>, 3>& data) {
+template <typename T>
+Matrix3x3T<T>::Matrix3x3T(const std::array<std::array<T, 3>, 3>& data) {
     for (int i = 0; i < 3; ++i) {
         for (int j = 0; j < 3; ++j) {
             mat_(i, j) = data[i][j];
@@ -16,86 +25,89 @@ Matrix3x3::Matrix3x3(const std::array<std::array<double, 3>, 3>& data) {
     }
 }
 
-Matrix3x3 Matrix3x3::identity() {
-    return Matrix3x3(Eigen::Matrix3d::Identity());
+template <typename T>
+Matrix3x3T<T> Matrix3x3T<T>::random() {
+    return Matrix3x3T(EigenMatrix::Random());
 }
 
-Matrix3x3 Matrix3x3::zero() {
-    return Matrix3x3(Eigen::Matrix3d::Zero());
+template <typename T>
+Matrix3x3T<T> Matrix3x3T<T>::inverse() const {
+    // Cofactors give the determinant and the inverse in one pass
+    EigenMatrix inverse;
+    T determinant;
+    bool invertible;
+    mat_.computeInverseAndDetWithCheck(inverse, determinant, invertible, detail::singularDeterminant<T>);
+    if (!invertible) {
+        throw std::runtime_error("Matrix is not invertible (determinant is zero)");
+    }
+    return Matrix3x3T(inverse);
 }
 
-Matrix3x3 Matrix3x3::random() {
-    return Matrix3x3(Eigen::Matrix3d::Random());
+template <typename T>
+bool Matrix3x3T<T>::isSymmetric(T tolerance) const {
+    const T scale = std::max(T(1), mat_.cwiseAbs().maxCoeff());
+    return std::abs(mat_(0, 1) - mat_(1, 0)) <= tolerance * scale &&
+           std::abs(mat_(0, 2) - mat_(2, 0)) <= tolerance * scale &&
+           std::abs(mat_(1, 2) - mat_(2, 1)) <= tolerance * scale;
 }
 
-double& Matrix3x3::operator()(int row, int col) {
-    if (row < 0 || row >= 3 || col < 0 || col >= 3) {
-        throw std::out_of_range("Matrix index out of range");
+template <typename T>
+typename Matrix3x3T<T>::EigenVector Matrix3x3T<T>::eigenvalues() const {
+    if (isSymmetric()) {
+        Eigen::SelfAdjointEigenSolver<EigenMatrix> solver;
+        solver.computeDirect(mat_, Eigen::EigenvaluesOnly);
+        return solver.eigenvalues();
     }
-    return mat_(row, col);
+    Eigen::EigenSolver<EigenMatrix> solver(mat_, false);
+    return solver.eigenvalues().real();
 }
 
-const double& Matrix3x3::operator()(int row, int col) const {
-    if (row < 0 || row >= 3 || col < 0 || col >= 3) {
-        throw std::out_of_range("Matrix index out of range");
+template <typename T>
+SymmetricEigenDecompositionT<T> Matrix3x3T<T>::symmetricEigen() const {
+    if (!isSymmetric()) {
+        throw std::invalid_argument("symmetricEigen requires a symmetric matrix");
     }
-    return mat_(row, col);
-}
-
-Matrix3x3 Matrix3x3::operator+(const Matrix3x3& other) const {
-    return Matrix3x3(mat_ + other.mat_);
+    Eigen::SelfAdjointEigenSolver<EigenMatrix> solver;
+    solver.computeDirect(mat_);
+    return { solver.eigenvalues(), Matrix3x3T(solver.eigenvectors()) };
 }
 
-Matrix3x3 Matrix3x3::operator-(const Matrix3x3& other) const {
-    return Matrix3x3(mat_ - other.mat_);
-}
-
-Matrix3x3 Matrix3x3::operator*(const Matrix3x3& other) const {
-    return Matrix3x3(mat_ * other.mat_);
-}
-
-Vector3 Matrix3x3::operator*(const Vector3& vec) const {
-    return Vector3(mat_ * vec.eigen());
-}
-
-Matrix3x3 Matrix3x3::operator*(double scalar) const {
-    return Matrix3x3(mat_ * scalar);
-}
+namespace {
 
-Matrix3x3 Matrix3x3::transpose() const {
-    return Matrix3x3(mat_.transpose());
-}
-
-double Matrix3x3::determinant() const {
-    return mat_.determinant();
-}
-
-Matrix3x3 Matrix3x3::inverse() const {
-    if (std::abs(mat_.determinant()) < 1e-10) {
-        throw std::runtime_error("Matrix is not invertible (determinant is zero)");
+template <typename T>
+void decomposeAll(std::span<const Matrix3x3T<T>> matrices, std::span<SymmetricEigenDecompositionT<T>> out) {
+    if (matrices.size() != out.size()) {
+        throw std::invalid_argument("symmetricEigenBatch input and output sizes do not match");
+    }
+    // Validate everything first so a rejected batch leaves `out` untouched
+    for (std::size_t i = 0; i < matrices.size(); ++i) {
+        if (!matrices[i].isSymmetric()) {
+            throw std::invalid_argument("symmetricEigenBatch requires symmetric matrices (matrix " +
+                                        std::to_string(i) + " is not)");
+        }
+    }
+    for (std::size_t i = 0; i < matrices.size(); ++i) {
+        out[i] = matrices[i].symmetricEigen();
     }
-    return Matrix3x3(mat_.inverse());
 }
 
-double Matrix3x3::trace() const {
-    return mat_.trace();
-}
+} // namespace
 
-double Matrix3x3::norm() const {
-    return mat_.norm();
+void symmetricEigenBatch(std::span<const Matrix3x3> matrices, std::span<SymmetricEigenDecomposition> out) {
+    decomposeAll(matrices, out);
 }
 
-Eigen::Vector3d Matrix3x3::eigenvalues() const {
-    Eigen::EigenSolver<Eigen::Matrix3d> solver(mat_);
-    return solver.eigenvalues().real();
+void symmetricEigenBatch(std::span<const Matrix3x3f> matrices, std::span<SymmetricEigenDecompositionf> out) {
+    decomposeAll(matrices, out);
 }
 
-std::ostream& operator<<(std::ostream& os, const Matrix3x3& m) {
-    os << "Matrix3x3:\n";
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const Matrix3x3T<T>& m) {
+    os << (std::is_same_v<T, float> ? "Matrix3x3f:\n" : "Matrix3x3:\n");
     for (int i = 0; i < 3; ++i) {
         os << "  [";
         for (int j = 0; j < 3; ++j) {
-            os << std::setw(8) << std::fixed << std::setprecision(3) << m.mat_(i, j);
+            os << std::setw(8) << std::fixed << std::setprecision(3) << m.at_unchecked(i, j);
             if (j < 2) os << ", ";
         }
         os << "]\n";
@@ -103,4 +115,21 @@ std::ostream& operator<<(std::ostream& os, const Matrix3x3& m) {
     return os;
 }
 
+template Matrix3x3T<float>::Matrix3x3T(const std::array<std::array<float, 3>, 3>& data);
+template Matrix3x3T<float> Matrix3x3T<float>::random();
+template Matrix3x3T<float> Matrix3x3T<float>::inverse() const;
+template bool Matrix3x3T<float>::isSymmetric(float tolerance) const;
+template Matrix3x3T<float>::EigenVector Matrix3x3T<float>::eigenvalues() const;
+template SymmetricEigenDecompositionT<float> Matrix3x3T<float>::symmetricEigen() const;
+
+template Matrix3x3T<double>::Matrix3x3T(const std::array<std::array<double, 3>, 3>& data);
+template Matrix3x3T<double> Matrix3x3T<double>::random();
+template Matrix3x3T<double> Matrix3x3T<double>::inverse() const;
+template bool Matrix3x3T<double>::isSymmetric(double tolerance) const;
+template Matrix3x3T<double>::EigenVector Matrix3x3T<double>::eigenvalues() const;
+template SymmetricEigenDecompositionT<double> Matrix3x3T<double>::symmetricEigen() const;
+
+template std::ostream& operator<<(std::ostream& os, const Matrix3x3T<float>& m);
+template std::ostream& operator<<(std::ostream& os, const Matrix3x3T<double>& m);
+
 } // namespace math_utils
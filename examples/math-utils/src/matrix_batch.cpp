@@ -0,0 +1,98 @@
+#include "math-utils/matrix_batch.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+namespace math_utils {
+
+namespace {
+
+// Matrices per chunk: large enough to amortize the claim, small enough for
+// idle threads to find work to steal near the end of a batch
+constexpr std::size_t kGrain = 4096;
+
+void checkSize(std::size_t expected, std::size_t actual, const char* what) {
+    if (expected != actual) {
+        throw std::invalid_argument(std::string(what) + " input and output sizes do not match");
+    }
+}
+
+template <typename T>
+void computeDeterminants(std::span<const Matrix3x3T<T>> matrices, std::span<T> out, ThreadPool& pool) {
+    checkSize(matrices.size(), out.size(), "determinantBatch");
+    pool.parallelFor(matrices.size(), kGrain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            out[i] = matrices[i].determinant();
+        }
+    });
+}
+
+template <typename T>
+std::size_t computeInverses(std::span<const Matrix3x3T<T>> matrices, std::span<Matrix3x3T<T>> out,
+                            std::span<InverseStatus> status, std::span<T> dets, bool storeDeterminants,
+                            ThreadPool& pool) {
+    checkSize(matrices.size(), out.size(), "inverseBatch");
+    checkSize(matrices.size(), status.size(), "inverseBatch");
+    if (storeDeterminants) {
+        checkSize(matrices.size(), dets.size(), "inverseBatch");
+    }
+
+    std::atomic<std::size_t> singular{0};
+    pool.parallelFor(matrices.size(), kGrain, [&](std::size_t begin, std::size_t end) {
+        std::size_t chunkSingular = 0;
+        typename Matrix3x3T<T>::EigenMatrix inverse;
+        for (std::size_t i = begin; i < end; ++i) {
+            T determinant;
+            bool invertible;
+            matrices[i].eigen().computeInverseAndDetWithCheck(inverse, determinant, invertible,
+                                                              detail::singularDeterminant<T>);
+            if (invertible) {
+                out[i].eigen() = inverse;
+                status[i] = InverseStatus::Ok;
+            } else {
+                out[i].eigen().setZero();
+                status[i] = InverseStatus::Singular;
+                ++chunkSingular;
+            }
+            if (storeDeterminants) {
+                dets[i] = determinant;
+            }
+        }
+        singular.fetch_add(chunkSingular, std::memory_order_relaxed);
+    });
+    return singular.load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+void determinantBatch(std::span<const Matrix3x3> matrices, std::span<double> out, ThreadPool& pool) {
+    computeDeterminants(matrices, out, pool);
+}
+
+void determinantBatch(std::span<const Matrix3x3f> matrices, std::span<float> out, ThreadPool& pool) {
+    computeDeterminants(matrices, out, pool);
+}
+
+std::size_t inverseBatch(std::span<const Matrix3x3> matrices, std::span<Matrix3x3> out,
+                         std::span<InverseStatus> status, ThreadPool& pool) {
+    return computeInverses<double>(matrices, out, status, {}, false, pool);
+}
+
+std::size_t inverseBatch(std::span<const Matrix3x3f> matrices, std::span<Matrix3x3f> out,
+                         std::span<InverseStatus> status, ThreadPool& pool) {
+    return computeInverses<float>(matrices, out, status, {}, false, pool);
+}
+
+std::size_t inverseBatch(std::span<const Matrix3x3> matrices, std::span<Matrix3x3> out,
+                         std::span<InverseStatus> status, std::span<double> determinants,
+                         ThreadPool& pool) {
+    return computeInverses(matrices, out, status, determinants, true, pool);
+}
+
+std::size_t inverseBatch(std::span<const Matrix3x3f> matrices, std::span<Matrix3x3f> out,
+                         std::span<InverseStatus> status, std::span<float> determinants,
+                         ThreadPool& pool) {
+    return computeInverses(matrices, out, status, determinants, true, pool);
+}
+
+} // namespace math_utils
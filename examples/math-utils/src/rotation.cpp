@@ -0,0 +1,88 @@
+#include "math-utils/rotation.hpp"
+#include "math-utils/transform.hpp"
+#include <stdexcept>
+
+namespace math_utils {
+
+namespace {
+
+template <typename T>
+void applyMatrix(const RigidTransformT<T>& transform, const T* in, T* out, std::size_t count) {
+    using Point = Eigen::Matrix<T, 3, 1>;
+    using Points = Eigen::Matrix<T, 3, Eigen::Dynamic>;
+    const Eigen::Matrix<T, 3, 3> matrix = transform.rotation().eigen().toRotationMatrix();
+    const Point& translation = transform.translation().eigen();
+    if (in != out) {
+        Eigen::Map<const Points> src(in, 3, static_cast<Eigen::Index>(count));
+        Eigen::Map<Points> dst(out, 3, static_cast<Eigen::Index>(count));
+        dst.noalias() = (matrix * src).colwise() + translation;
+        return;
+    }
+    // In place: one point at a time, so no whole-array temporary
+    for (std::size_t i = 0; i < count; ++i) {
+        Eigen::Map<Point> point(out + 3 * i);
+        const Point result = matrix * point + translation;
+        point = result;
+    }
+}
+
+} // namespace
+
+template <typename T>
+RotationT<T>::RotationT(const EigenQuaternion& q) {
+    const T norm = q.norm();
+    if (norm == T(0)) {
+        throw std::invalid_argument("Rotation requires a non-zero quaternion");
+    }
+    q_ = EigenQuaternion(q.coeffs() / norm);
+}
+
+template <typename T>
+RotationT<T> RotationT<T>::fromAxisAngle(const Vector3T<T>& axis, T angle) {
+    return fromUnit(EigenQuaternion(Eigen::AngleAxis<T>(angle, axis.normalized().eigen())));
+}
+
+template <typename T>
+RotationT<T> RotationT<T>::fromMatrix(const Matrix3x3T<T>& matrix) {
+    if (!(matrix.determinant() > T(0))) {
+        throw std::invalid_argument("Rotation requires a matrix with positive determinant");
+    }
+    return RotationT(EigenQuaternion(matrix.eigen()));
+}
+
+template class RotationT<float>;
+template class RotationT<double>;
+template class RigidTransformT<float>;
+template class RigidTransformT<double>;
+
+void transformPoints(const RigidTransform& transform, std::span<const Vector3> in, std::span<Vector3> out) {
+    transformPoints(transform.rotation().toMatrix(), in, out, transform.translation());
+}
+
+void transformPointsInPlace(const RigidTransform& transform, std::span<Vector3> points) {
+    transformPointsInPlace(transform.rotation().toMatrix(), points, transform.translation());
+}
+
+void transformPoints(const RigidTransform& transform, const Vector3Batch& in, Vector3Batch& out) {
+    transformPoints(transform.rotation().toMatrix(), in, out, transform.translation());
+}
+
+void transformPointsInPlace(const RigidTransform& transform, Vector3Batch& points) {
+    transformPointsInPlace(transform.rotation().toMatrix(), points, transform.translation());
+}
+
+// The SIMD kernels in transform.cpp are double-only; Eigen vectorizes the
+// single-precision product over the packed xyz array directly
+void transformPoints(const RigidTransformf& transform, std::span<const Vector3f> in, std::span<Vector3f> out) {
+    if (in.size() != out.size()) {
+        throw std::invalid_argument("transformPoints input and output sizes do not match");
+    }
+    static_assert(sizeof(Vector3f) == 3 * sizeof(float));
+    applyMatrix(transform, in.empty() ? nullptr : in.front().data(), out.empty() ? nullptr : out.front().data(), in.size());
+}
+
+void transformPointsInPlace(const RigidTransformf& transform, std::span<Vector3f> points) {
+    transformPoints(transform, points, points);
+}
+
+} // namespace math_utils
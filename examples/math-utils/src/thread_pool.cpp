@@ -0,0 +1,156 @@
+#include "math-utils/thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace math_utils {
+
+namespace {
+
+// Set on pool workers, and on the calling thread while it runs a loop, so
+// nested parallelFor calls run inline instead of waiting on themselves
+thread_local bool insideLoop = false;
+
+} // namespace
+
+struct ThreadPool::Job {
+    // Own cache line per section so claims on one do not contend with another
+    struct alignas(64) Section {
+        std::atomic<std::size_t> next{0};
+        std::size_t end = 0;
+    };
+
+    Job(std::size_t sectionCount, std::size_t count, std::size_t grain,
+        const std::function<void(std::size_t, std::size_t)>& body)
+        : body(body), grain(grain), sectionCount(sectionCount),
+          sections(std::make_unique<Section[]>(sectionCount)) {
+        // Section boundaries fall on chunk boundaries so every claimed
+        // chunk is a whole one
+        const std::size_t chunks = (count + grain - 1) / grain;
+        for (std::size_t k = 0; k < sectionCount; ++k) {
+            sections[k].next.store(std::min(count, chunks * k / sectionCount * grain), std::memory_order_relaxed);
+            sections[k].end = std::min(count, chunks * (k + 1) / sectionCount * grain);
+        }
+    }
+
+    const std::function<void(std::size_t, std::size_t)>& body;
+    const std::size_t grain;
+    const std::size_t sectionCount;
+    std::unique_ptr<Section[]> sections;
+
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::global() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::parallelFor(std::size_t count, std::size_t grain,
+                             const std::function<void(std::size_t, std::size_t)>& body) {
+    grain = std::max<std::size_t>(grain, 1);
+    if (workers_.empty() || insideLoop || count <= grain) {
+        for (std::size_t begin = 0; begin < count; begin += grain) {
+            body(begin, std::min(begin + grain, count));
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit(submitMutex_);
+    Job job(size(), count, grain, body);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &job;
+        ++generation_;
+        running_ = workers_.size();
+    }
+    wake_.notify_all();
+
+    insideLoop = true;
+    runJob(job, 0);
+    insideLoop = false;
+
+    {
+        // Every worker takes part in every job, so none can still be
+        // looking at this one once the count drops to zero
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return running_ == 0; });
+        job_ = nullptr;
+    }
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+void ThreadPool::workerLoop(std::size_t index) {
+    insideLoop = true;
+    std::uint64_t seen = 0;
+    for (;;) {
+        Job* job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+            job = job_;
+        }
+        runJob(*job, index);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--running_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::runJob(Job& job, std::size_t index) {
+    try {
+        // Own section first, then steal from the others in turn
+        for (std::size_t k = 0; k < job.sectionCount; ++k) {
+            Job::Section& section = job.sections[(index + k) % job.sectionCount];
+            for (;;) {
+                const std::size_t begin = section.next.fetch_add(job.grain, std::memory_order_relaxed);
+                if (begin >= section.end) {
+                    break;
+                }
+                job.body(begin, std::min(begin + job.grain, section.end));
+            }
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(job.errorMutex);
+        if (!job.error) {
+            job.error = std::current_exception();
+        }
+        for (std::size_t k = 0; k < job.sectionCount; ++k) {
+            job.sections[k].next.store(job.sections[k].end, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace math_utils
@@ -0,0 +1,228 @@
+#include "math-utils/transform.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MATH_UTILS_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace math_utils {
+
+namespace {
+
+// Kernels read the matrix as 9 row-major coefficients and the translation as
+// 3 coefficients. Output arrays may alias the input arrays exactly.
+using TransformKernel = void (*)(const double* m, const double* t,
+                                 const double* xs, const double* ys, const double* zs,
+                                 double* ox, double* oy, double* oz, std::size_t n);
+
+void transformScalar(const double* m, const double* t,
+                     const double* xs, const double* ys, const double* zs,
+                     double* ox, double* oy, double* oz, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const double x = xs[i];
+        const double y = ys[i];
+        const double z = zs[i];
+        ox[i] = m[0] * x + m[1] * y + m[2] * z + t[0];
+        oy[i] = m[3] * x + m[4] * y + m[5] * z + t[1];
+        oz[i] = m[6] * x + m[7] * y + m[8] * z + t[2];
+    }
+}
+
+#ifdef MATH_UTILS_X86_SIMD
+// Remainder of the SIMD kernels. Rounds like their vector bodies, with the
+// same fma nesting, so every point in a batch gets the same result whatever
+// its position relative to the vector width.
+__attribute__((target("fma")))
+void transformFmaTail(const double* m, const double* t,
+                      const double* xs, const double* ys, const double* zs,
+                      double* ox, double* oy, double* oz, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const double x = xs[i];
+        const double y = ys[i];
+        const double z = zs[i];
+        ox[i] = std::fma(m[0], x, std::fma(m[1], y, std::fma(m[2], z, t[0])));
+        oy[i] = std::fma(m[3], x, std::fma(m[4], y, std::fma(m[5], z, t[1])));
+        oz[i] = std::fma(m[6], x, std::fma(m[7], y, std::fma(m[8], z, t[2])));
+    }
+}
+
+__attribute__((target("avx2,fma")))
+void transformAvx2(const double* m, const double* t,
+                   const double* xs, const double* ys, const double* zs,
+                   double* ox, double* oy, double* oz, std::size_t n) {
+    const __m256d m00 = _mm256_set1_pd(m[0]), m01 = _mm256_set1_pd(m[1]), m02 = _mm256_set1_pd(m[2]);
+    const __m256d m10 = _mm256_set1_pd(m[3]), m11 = _mm256_set1_pd(m[4]), m12 = _mm256_set1_pd(m[5]);
+    const __m256d m20 = _mm256_set1_pd(m[6]), m21 = _mm256_set1_pd(m[7]), m22 = _mm256_set1_pd(m[8]);
+    const __m256d t0 = _mm256_set1_pd(t[0]), t1 = _mm256_set1_pd(t[1]), t2 = _mm256_set1_pd(t[2]);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d x = _mm256_loadu_pd(xs + i);
+        const __m256d y = _mm256_loadu_pd(ys + i);
+        const __m256d z = _mm256_loadu_pd(zs + i);
+        _mm256_storeu_pd(ox + i, _mm256_fmadd_pd(m00, x, _mm256_fmadd_pd(m01, y, _mm256_fmadd_pd(m02, z, t0))));
+        _mm256_storeu_pd(oy + i, _mm256_fmadd_pd(m10, x, _mm256_fmadd_pd(m11, y, _mm256_fmadd_pd(m12, z, t1))));
+        _mm256_storeu_pd(oz + i, _mm256_fmadd_pd(m20, x, _mm256_fmadd_pd(m21, y, _mm256_fmadd_pd(m22, z, t2))));
+    }
+    transformFmaTail(m, t, xs + i, ys + i, zs + i, ox + i, oy + i, oz + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+void transformAvx512(const double* m, const double* t,
+                     const double* xs, const double* ys, const double* zs,
+                     double* ox, double* oy, double* oz, std::size_t n) {
+    const __m512d m00 = _mm512_set1_pd(m[0]), m01 = _mm512_set1_pd(m[1]), m02 = _mm512_set1_pd(m[2]);
+    const __m512d m10 = _mm512_set1_pd(m[3]), m11 = _mm512_set1_pd(m[4]), m12 = _mm512_set1_pd(m[5]);
+    const __m512d m20 = _mm512_set1_pd(m[6]), m21 = _mm512_set1_pd(m[7]), m22 = _mm512_set1_pd(m[8]);
+    const __m512d t0 = _mm512_set1_pd(t[0]), t1 = _mm512_set1_pd(t[1]), t2 = _mm512_set1_pd(t[2]);
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m512d x = _mm512_loadu_pd(xs + i);
+        const __m512d y = _mm512_loadu_pd(ys + i);
+        const __m512d z = _mm512_loadu_pd(zs + i);
+        _mm512_storeu_pd(ox + i, _mm512_fmadd_pd(m00, x, _mm512_fmadd_pd(m01, y, _mm512_fmadd_pd(m02, z, t0))));
+        _mm512_storeu_pd(oy + i, _mm512_fmadd_pd(m10, x, _mm512_fmadd_pd(m11, y, _mm512_fmadd_pd(m12, z, t1))));
+        _mm512_storeu_pd(oz + i, _mm512_fmadd_pd(m20, x, _mm512_fmadd_pd(m21, y, _mm512_fmadd_pd(m22, z, t2))));
+    }
+    transformFmaTail(m, t, xs + i, ys + i, zs + i, ox + i, oy + i, oz + i, n - i);
+}
+#endif
+
+SimdLevel detectSimdLevel() {
+#ifdef MATH_UTILS_X86_SIMD
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdLevel::AVX2;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+std::atomic<SimdLevel>& activeSimdLevel() {
+    static std::atomic<SimdLevel> level{detectSimdLevel()};
+    return level;
+}
+
+TransformKernel selectKernel() {
+    switch (activeSimdLevel().load(std::memory_order_relaxed)) {
+#ifdef MATH_UTILS_X86_SIMD
+        case SimdLevel::AVX512: return transformAvx512;
+        case SimdLevel::AVX2: return transformAvx2;
+#endif
+        default: return transformScalar;
+    }
+}
+
+struct Coefficients {
+    double m[9];
+    double t[3];
+};
+
+Coefficients coefficients(const Matrix3x3& matrix, const Vector3& translation) {
+    const Eigen::Matrix3d& mat = matrix.eigen();
+    return {
+        {mat(0, 0), mat(0, 1), mat(0, 2),
+         mat(1, 0), mat(1, 1), mat(1, 2),
+         mat(2, 0), mat(2, 1), mat(2, 2)},
+        {translation.x(), translation.y(), translation.z()}
+    };
+}
+
+// Points in array-of-structures layout are staged through small
+// stack-resident SoA blocks so the same SIMD kernels apply.
+constexpr std::size_t kBlockSize = 256;
+
+void transformBlocks(const Coefficients& c, std::span<const Vector3> in, std::span<Vector3> out) {
+    if (in.size() != out.size()) {
+        throw std::invalid_argument("transformPoints input and output sizes do not match");
+    }
+    const TransformKernel kernel = selectKernel();
+    alignas(64) double bx[kBlockSize];
+    alignas(64) double by[kBlockSize];
+    alignas(64) double bz[kBlockSize];
+
+    for (std::size_t start = 0; start < in.size(); start += kBlockSize) {
+        const std::size_t count = std::min(kBlockSize, in.size() - start);
+        for (std::size_t j = 0; j < count; ++j) {
+            const Eigen::Vector3d& p = in[start + j].eigen();
+            bx[j] = p(0);
+            by[j] = p(1);
+            bz[j] = p(2);
+        }
+        kernel(c.m, c.t, bx, by, bz, bx, by, bz, count);
+        for (std::size_t j = 0; j < count; ++j) {
+            Eigen::Vector3d& p = out[start + j].eigen();
+            p(0) = bx[j];
+            p(1) = by[j];
+            p(2) = bz[j];
+        }
+    }
+}
+
+} // namespace
+
+SimdLevel simdLevel() {
+    return activeSimdLevel().load(std::memory_order_relaxed);
+}
+
+bool simdLevelSupported(SimdLevel level) {
+    return static_cast<int>(level) <= static_cast<int>(detectSimdLevel());
+}
+
+void setSimdLevel(SimdLevel level) {
+    if (!simdLevelSupported(level)) {
+        throw std::invalid_argument(std::string("SIMD level not supported by this CPU: ") + simdLevelName(level));
+    }
+    activeSimdLevel().store(level, std::memory_order_relaxed);
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::AVX512: return "avx512";
+    }
+    return "unknown";
+}
+
+void transformPoints(const Matrix3x3& matrix, std::span<const Vector3> in, std::span<Vector3> out,
+                     const Vector3& translation) {
+    transformBlocks(coefficients(matrix, translation), in, out);
+}
+
+void transformPointsInPlace(const Matrix3x3& matrix, std::span<Vector3> points,
+                            const Vector3& translation) {
+    transformBlocks(coefficients(matrix, translation), points, points);
+}
+
+void transformPoints(const Matrix3x3& matrix, const Vector3Batch& in, Vector3Batch& out,
+                     const Vector3& translation) {
+    if (&in == &out) {
+        transformPointsInPlace(matrix, out, translation);
+        return;
+    }
+    if (out.size() != in.size()) {
+        out = Vector3Batch(in.size());
+    }
+    const Coefficients c = coefficients(matrix, translation);
+    selectKernel()(c.m, c.t, in.xs().data(), in.ys().data(), in.zs().data(),
+                   out.xs().data(), out.ys().data(), out.zs().data(), in.size());
+}
+
+void transformPointsInPlace(const Matrix3x3& matrix, Vector3Batch& points,
+                            const Vector3& translation) {
+    const Coefficients c = coefficients(matrix, translation);
+    selectKernel()(c.m, c.t, points.xs().data(), points.ys().data(), points.zs().data(),
+                   points.xs().data(), points.ys().data(), points.zs().data(), points.size());
+}
+
+} // namespace math_utils
@@ -0,0 +1,113 @@
+#include "math-utils/vector_batch.hpp"
+#include <stdexcept>
+#include <utility>
+
+namespace math_utils {
+
+Vector3Batch::Vector3Batch(std::size_t size)
+    : x_(Eigen::ArrayXd::Zero(static_cast<Eigen::Index>(size))),
+      y_(Eigen::ArrayXd::Zero(static_cast<Eigen::Index>(size))),
+      z_(Eigen::ArrayXd::Zero(static_cast<Eigen::Index>(size))) {}
+
+Vector3Batch::Vector3Batch(const std::vector<Vector3>& vectors) : Vector3Batch(vectors.size()) {
+    for (std::size_t i = 0; i < vectors.size(); ++i) {
+        set(i, vectors[i]);
+    }
+}
+
+Vector3Batch::Vector3Batch(Eigen::ArrayXd xs, Eigen::ArrayXd ys, Eigen::ArrayXd zs)
+    : x_(std::move(xs)), y_(std::move(ys)), z_(std::move(zs)) {
+    if (y_.size() != x_.size() || z_.size() != x_.size()) {
+        throw std::invalid_argument("Vector3Batch component arrays must have the same size");
+    }
+}
+
+Vector3 Vector3Batch::operator[](std::size_t index) const {
+    if (index >= size()) {
+        throw std::out_of_range("Vector3Batch index out of range");
+    }
+    const auto i = static_cast<Eigen::Index>(index);
+    return Vector3(x_(i), y_(i), z_(i));
+}
+
+void Vector3Batch::set(std::size_t index, const Vector3& vec) {
+    if (index >= size()) {
+        throw std::out_of_range("Vector3Batch index out of range");
+    }
+    const auto i = static_cast<Eigen::Index>(index);
+    x_(i) = vec.x();
+    y_(i) = vec.y();
+    z_(i) = vec.z();
+}
+
+std::vector<Vector3> Vector3Batch::toVectors() const {
+    std::vector<Vector3> result;
+    result.reserve(size());
+    for (Eigen::Index i = 0; i < x_.size(); ++i) {
+        result.emplace_back(x_(i), y_(i), z_(i));
+    }
+    return result;
+}
+
+Vector3Batch Vector3Batch::operator+(const Vector3Batch& other) const {
+    checkSameSize(other);
+    return Vector3Batch(x_ + other.x_, y_ + other.y_, z_ + other.z_);
+}
+
+Vector3Batch Vector3Batch::operator-(const Vector3Batch& other) const {
+    checkSameSize(other);
+    return Vector3Batch(x_ - other.x_, y_ - other.y_, z_ - other.z_);
+}
+
+Vector3Batch Vector3Batch::operator*(double scalar) const {
+    return Vector3Batch(x_ * scalar, y_ * scalar, z_ * scalar);
+}
+
+Vector3Batch Vector3Batch::operator+(const Vector3& vec) const {
+    return Vector3Batch(x_ + vec.x(), y_ + vec.y(), z_ + vec.z());
+}
+
+Vector3Batch Vector3Batch::operator-(const Vector3& vec) const {
+    return Vector3Batch(x_ - vec.x(), y_ - vec.y(), z_ - vec.z());
+}
+
+Eigen::ArrayXd Vector3Batch::magnitude() const {
+    return squaredNorm().sqrt();
+}
+
+Eigen::ArrayXd Vector3Batch::squaredNorm() const {
+    return x_ * x_ + y_ * y_ + z_ * z_;
+}
+
+Vector3Batch Vector3Batch::normalized() const {
+    const Eigen::ArrayXd norms = magnitude();
+    if ((norms == 0.0).any()) {
+        throw std::runtime_error("Cannot normalize zero vector");
+    }
+    return Vector3Batch(x_ / norms, y_ / norms, z_ / norms);
+}
+
+Eigen::ArrayXd Vector3Batch::dot(const Vector3Batch& other) const {
+    checkSameSize(other);
+    return x_ * other.x_ + y_ * other.y_ + z_ * other.z_;
+}
+
+Vector3Batch Vector3Batch::cross(const Vector3Batch& other) const {
+    checkSameSize(other);
+    return Vector3Batch(y_ * other.z_ - z_ * other.y_,
+                        z_ * other.x_ - x_ * other.z_,
+                        x_ * other.y_ - y_ * other.x_);
+}
+
+Vector3Batch Vector3Batch::cwiseProduct(const Vector3Batch& other) const {
+    checkSameSize(other);
+    return Vector3Batch(x_ * other.x_, y_ * other.y_, z_ * other.z_);
+}
+
+void Vector3Batch::checkSameSize(const Vector3Batch& other) const {
+    if (other.size() != size()) {
+        throw std::invalid_argument("Vector3Batch sizes do not match");
+    }
+}
+
+} // namespace math_utils
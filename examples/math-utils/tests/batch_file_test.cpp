@@ -0,0 +1,238 @@
+#include "math-utils/batch_file.hpp"
+#include "math-utils/transform.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace math_utils;
+
+namespace {
+
+template <typename T>
+struct Output {
+    BatchFileHeader header;
+    std::vector<T> values;
+};
+
+template <typename T>
+Output<T> readOutput(const std::string& path) {
+    MappedFile file(path);
+    Output<T> output;
+    std::memcpy(&output.header, file.bytes().data(), sizeof(BatchFileHeader));
+    output.values.resize((file.bytes().size() - sizeof(BatchFileHeader)) / sizeof(T));
+    std::memcpy(output.values.data(), file.bytes().data() + sizeof(BatchFileHeader), output.values.size() * sizeof(T));
+    return output;
+}
+
+template <typename F>
+bool throws(F&& f) {
+    try {
+        f();
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+std::vector<Vector3> makeVectors(std::size_t count) {
+    std::vector<Vector3> vectors;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double s = static_cast<double>(i);
+        vectors.emplace_back(std::sin(s), std::cos(s * 0.5) * 3.0, s * 0.01 - 2.0);
+    }
+    vectors[3] = Vector3();  // Normalize leaves zero vectors as zero
+    return vectors;
+}
+
+std::vector<Matrix3x3> makeMatrices(std::size_t count) {
+    std::vector<Matrix3x3> matrices;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double s = static_cast<double>(i % 17) * 0.1;
+        Matrix3x3 m({{{2.0 + s, 0.5, -1.0}, {0.5, 3.0, s}, {-1.0, s, 1.0}}});
+        matrices.push_back(i % 2 == 0 ? m : Matrix3x3(m * m.transpose() + Matrix3x3::identity() * s));
+    }
+    matrices[1](0, 2) = 4.0;  // Non-symmetric takes the general solver
+    return matrices;
+}
+
+} // namespace
+
+void test_parse_steps() {
+    std::cout << "Testing batch step parsing...\n";
+
+    assert(parseBatchStep("normalize").op == BatchOp::Normalize);
+    assert(parseBatchStep("determinant").op == BatchOp::Determinant);
+    assert(parseBatchStep("eigenvalues").op == BatchOp::Eigenvalues);
+
+    BatchStep rotate = parseBatchStep("transform:0,-1,0,1,0,0,0,0,1");
+    assert(rotate.op == BatchOp::Transform);
+    assert(rotate.matrix(0, 1) == -1.0 && rotate.matrix(1, 0) == 1.0);
+    assert(rotate.translation.squaredNorm() == 0.0);
+
+    BatchStep shift = parseBatchStep("transform:1,0,0,0,1,0,0,0,1,1.5,-2,3e2");
+    assert(shift.translation.x() == 1.5 && shift.translation.y() == -2.0 && shift.translation.z() == 300.0);
+
+    assert(throws([] { parseBatchStep("invert"); }));
+    assert(throws([] { parseBatchStep("transform:1,0,0"); }));
+    assert(throws([] { parseBatchStep("transform:1,0,0,0,1,0,0,0,x"); }));
+
+    std::cout << "✓ Batch step parsing tests passed\n";
+}
+
+void test_vector_pipeline() {
+    std::cout << "Testing vector pipeline against the scalar API...\n";
+
+    const std::vector<Vector3> vectors = makeVectors(10000);
+    writeBatchFile("batch_vectors.mub", vectors);
+
+    const std::vector<BatchStep> steps = {
+        parseBatchStep("transform:0,-1,0,1,0,0,0,0,2,1,2,3"),
+        parseBatchStep("normalize"),
+    };
+    // Small chunks so the pipeline crosses many chunk boundaries
+    const BatchResult result = runBatch("batch_vectors.mub", "batch_normalized.mub", steps, 1000 + 7);
+    assert(result.count == vectors.size() && result.width == 3);
+
+    const Output<double> output = readOutput<double>("batch_normalized.mub");
+    assert(output.header.count == vectors.size() && output.header.width == 3 && output.header.scalarSize == 8);
+    assert(result.bytesWritten == sizeof(BatchFileHeader) + output.values.size() * sizeof(double));
+
+    std::vector<Vector3> transformed(vectors.size());
+    transformPoints(steps[0].matrix, vectors, transformed, steps[0].translation);
+    std::size_t zeros = 0;
+    for (std::size_t i = 0; i < vectors.size(); ++i) {
+        Vector3 expected;
+        if (transformed[i].squaredNorm() != 0.0) {
+            expected = transformed[i].normalized();
+        } else {
+            ++zeros;
+        }
+        const Vector3 actual(output.values[3 * i], output.values[3 * i + 1], output.values[3 * i + 2]);
+        assert((actual - expected).magnitude() < 1e-12);
+    }
+    assert(result.zeroVectors == zeros);
+
+    std::cout << "✓ Vector pipeline tests passed\n";
+}
+
+void test_matrix_pipeline() {
+    std::cout << "Testing matrix pipeline against the scalar API...\n";
+
+    const std::vector<Matrix3x3> matrices = makeMatrices(3000);
+    writeBatchFile("batch_matrices.mub", matrices);
+
+    const BatchStep determinant = parseBatchStep("determinant");
+    BatchResult result = runBatch("batch_matrices.mub", "batch_determinants.mub", {&determinant, 1}, 512);
+    assert(result.width == 1);
+    const Output<double> dets = readOutput<double>("batch_determinants.mub");
+    for (std::size_t i = 0; i < matrices.size(); ++i) {
+        assert(dets.values[i] == matrices[i].determinant());
+    }
+
+    const BatchStep eigenvalues = parseBatchStep("eigenvalues");
+    result = runBatch("batch_matrices.mub", "batch_eigenvalues.mub", {&eigenvalues, 1});
+    assert(result.width == 3);
+    const Output<double> eig = readOutput<double>("batch_eigenvalues.mub");
+    for (std::size_t i = 0; i < matrices.size(); ++i) {
+        const Eigen::Vector3d expected = matrices[i].eigenvalues();
+        assert(eig.values[3 * i] == expected(0) && eig.values[3 * i + 2] == expected(2));
+    }
+
+    // Outputs are batch files, so pipelines chain
+    const BatchStep normalize = parseBatchStep("normalize");
+    result = runBatch("batch_eigenvalues.mub", "batch_chained.mub", {&normalize, 1});
+    assert(result.count == matrices.size());
+
+    std::cout << "✓ Matrix pipeline tests passed\n";
+}
+
+void test_float_pipeline() {
+    std::cout << "Testing single-precision pipeline...\n";
+
+    std::vector<Vector3f> vectors;
+    for (const Vector3& v : makeVectors(2000)) {
+        vectors.push_back(v.cast<float>());
+    }
+    writeBatchFile("batch_vectors_f.mub", vectors);
+
+    // No steps copies the elements straight from the mapping
+    BatchResult result = runBatch("batch_vectors_f.mub", "batch_copy_f.mub", {});
+    const Output<float> copy = readOutput<float>("batch_copy_f.mub");
+    assert(result.width == 3 && copy.header.scalarSize == 4);
+    assert(std::memcmp(copy.values.data(), vectors.data(), vectors.size() * sizeof(Vector3f)) == 0);
+
+    const BatchStep normalize = parseBatchStep("normalize");
+    result = runBatch("batch_vectors_f.mub", "batch_normalized_f.mub", {&normalize, 1});
+    const Output<float> normalized = readOutput<float>("batch_normalized_f.mub");
+    for (std::size_t i = 0; i < vectors.size(); ++i) {
+        if (i == 3) {
+            continue;
+        }
+        const Vector3f expected = vectors[i].normalized();
+        assert(normalized.values[3 * i] == expected.x() && normalized.values[3 * i + 2] == expected.z());
+    }
+    assert(result.zeroVectors == 1);
+
+    std::cout << "✓ Single-precision pipeline tests passed\n";
+}
+
+void test_batch_errors() {
+    std::cout << "Testing batch error handling...\n";
+
+    const BatchStep determinant = parseBatchStep("determinant");
+    const BatchStep normalize = parseBatchStep("normalize");
+
+    // Steps must accept the element type they receive
+    assert(throws([&] { runBatch("batch_vectors.mub", "batch_error.mub", {&determinant, 1}); }));
+    const BatchStep pipeline[] = {determinant, normalize};
+    assert(throws([&] { runBatch("batch_matrices.mub", "batch_error.mub", pipeline); }));
+
+    // Malformed inputs
+    {
+        std::ofstream out("batch_garbage.mub", std::ios::binary);
+        out << "not a batch file at all";
+    }
+    assert(throws([&] { runBatch("batch_garbage.mub", "batch_error.mub", {}); }));
+
+    const std::vector<Vector3> vectors = makeVectors(10);
+    writeBatchFile("batch_truncated.mub", vectors);
+    {
+        std::ofstream out("batch_truncated.mub", std::ios::binary | std::ios::in);
+        out.seekp(8);
+        const std::uint64_t count = 11;
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+    assert(throws([&] { runBatch("batch_truncated.mub", "batch_error.mub", {}); }));
+
+    // In-place processing would truncate the mapped input
+    assert(throws([&] { runBatch("batch_vectors.mub", "batch_vectors.mub", {&normalize, 1}); }));
+    assert(MappedFile("batch_vectors.mub").bytes().size() > sizeof(BatchFileHeader));
+
+    bool missing = false;
+    try {
+        runBatch("batch_missing.mub", "batch_error.mub", {});
+    } catch (const std::runtime_error&) {
+        missing = true;
+    }
+    assert(missing);
+
+    std::cout << "✓ Batch error handling tests passed\n";
+}
+
+int main() {
+    std::cout << "Running Batch File Tests\n";
+    std::cout << "=======================\n";
+
+    test_parse_steps();
+    test_vector_pipeline();
+    test_matrix_pipeline();
+    test_float_pipeline();
+    test_batch_errors();
+
+    std::cout << "\n✓ All batch file tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,78 @@
+// This test is compiled with the opposite NDEBUG setting from the library
+// it links against, like a release application using a debug build of the
+// library or the other way round. Bounds checks must follow this file's
+// setting whichever order the objects are linked in.
+//
+// Results are checked with expect() rather than assert, which the flipped
+// NDEBUG may compile out.
+#ifdef NDEBUG
+#undef NDEBUG
+#else
+#define NDEBUG
+#endif
+
+#include "math-utils/matrix.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+using namespace math_utils;
+
+namespace {
+
+void expect(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << "\n";
+        std::abort();
+    }
+}
+
+template <typename Access>
+bool throwsOutOfRange(Access access) {
+    try {
+        access();
+    } catch (const std::out_of_range&) {
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+void test_consumer_policy() {
+    std::cout << "Testing bounds checks follow the caller's NDEBUG...\n";
+
+    constexpr bool checked = MATH_UTILS_BOUNDS_CHECK != 0;
+    Matrix3x3 m({{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}});
+    const Matrix3x3& view = m;
+
+    expect(m(1, 2) == 6.0 && view(2, 0) == 7.0, "in-range access");
+    expect(throwsOutOfRange([&] { (void)m(3, 0); }) == checked, "inlined operator()");
+    expect(throwsOutOfRange([&] { (void)view(0, -1); }) == checked, "inlined const operator()");
+    expect(throwsOutOfRange([&] { (void)(m * 2.0)(3, 0); }) == checked, "expression operator()");
+
+    // Calls through member pointers use an out-of-line definition of
+    // operator() instead of inlining it here
+    double& (Matrix3x3::*access)(int, int) = &Matrix3x3::operator();
+    const float& (Matrix3x3f::*constAccess)(int, int) const = &Matrix3x3f::operator();
+    const Matrix3x3f mf(m);
+    expect((m.*access)(0, 1) == 2.0 && (mf.*constAccess)(1, 1) == 5.0f, "out-of-line in-range access");
+    expect(throwsOutOfRange([&] { (void)(m.*access)(3, 0); }) == checked, "out-of-line operator()");
+    expect(throwsOutOfRange([&] { (void)(mf.*constAccess)(3, 0); }) == checked, "out-of-line const operator()");
+
+    // An explicit policy argument overrides the default in either build
+    expect(throwsOutOfRange([&] { (void)m.operator()<true>(3, 0); }), "explicitly checked operator()");
+    expect(m.operator()<false>(2, 2) == 9.0, "explicitly unchecked operator()");
+
+    std::cout << "✓ Bounds check policy tests passed\n";
+}
+
+int main() {
+    std::cout << "Running Bounds Check Tests\n";
+    std::cout << "==========================\n";
+
+    test_consumer_policy();
+
+    std::cout << "\n✓ All bounds check tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include "math-utils/matrix_batch.hpp"
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace math_utils;
+
+namespace {
+
+// Invertible matrices with a few exactly singular ones mixed in
+std::vector<Matrix3x3> makeMatrices(std::size_t count) {
+    std::vector<Matrix3x3> matrices;
+    matrices.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const double s = static_cast<double>(i % 97) * 0.01;
+        if (i % 1000 == 7) {
+            matrices.push_back(Matrix3x3({{{1.0, 2.0, 3.0}, {2.0, 4.0, 6.0}, {s, 1.0, 0.0}}}));
+        } else {
+            matrices.push_back(Matrix3x3({{{2.0 + s, 0.5, -1.0}, {0.25, 3.0 - s, 0.75}, {1.0, s, 4.0}}}));
+        }
+    }
+    return matrices;
+}
+
+} // namespace
+
+void test_thread_pool() {
+    std::cout << "Testing work-stealing thread pool...\n";
+
+    for (std::size_t threads : {1, 2, 4, 7}) {
+        ThreadPool pool(threads);
+        assert(pool.size() == threads);
+
+        // Every index is visited exactly once, in chunks of at most `grain`
+        std::vector<std::atomic<int>> visits(10007);
+        pool.parallelFor(visits.size(), 64, [&](std::size_t begin, std::size_t end) {
+            assert(end > begin && end - begin <= 64);
+            for (std::size_t i = begin; i < end; ++i) {
+                visits[i].fetch_add(1);
+            }
+        });
+        for (const auto& count : visits) {
+            assert(count.load() == 1);
+        }
+
+        // Nested loops run inline rather than deadlocking
+        std::atomic<std::size_t> nested{0};
+        pool.parallelFor(8, 1, [&](std::size_t, std::size_t) {
+            pool.parallelFor(100, 10, [&](std::size_t begin, std::size_t end) { nested += end - begin; });
+        });
+        assert(nested.load() == 800);
+
+        // The first exception reaches the caller and the pool stays usable
+        bool caught = false;
+        try {
+            pool.parallelFor(1000, 10, [](std::size_t begin, std::size_t) {
+                if (begin == 500) {
+                    throw std::runtime_error("chunk failed");
+                }
+            });
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        assert(caught);
+
+        std::atomic<std::size_t> total{0};
+        pool.parallelFor(1000, 10, [&](std::size_t begin, std::size_t end) { total += end - begin; });
+        assert(total.load() == 1000);
+
+        pool.parallelFor(0, 10, [](std::size_t, std::size_t) { assert(false); });
+    }
+
+    std::cout << "✓ Thread pool tests passed\n";
+}
+
+void test_batch_matches_scalar() {
+    std::cout << "Testing batched determinant/inverse against per-matrix API...\n";
+
+    const std::vector<Matrix3x3> matrices = makeMatrices(20000);
+    std::vector<double> dets(matrices.size());
+    std::vector<Matrix3x3> inverses(matrices.size());
+    std::vector<InverseStatus> status(matrices.size());
+    std::vector<double> invDets(matrices.size());
+
+    ThreadPool pool(4);
+    determinantBatch(matrices, dets, pool);
+    const std::size_t singular = inverseBatch(matrices, inverses, status, invDets, pool);
+
+    std::size_t expectedSingular = 0;
+    for (std::size_t i = 0; i < matrices.size(); ++i) {
+        assert(std::abs(dets[i] - matrices[i].determinant()) <= 1e-12 * std::max(1.0, std::abs(dets[i])));
+        assert(std::abs(invDets[i] - dets[i]) <= 1e-12 * std::max(1.0, std::abs(dets[i])));
+        if (i % 1000 == 7) {
+            ++expectedSingular;
+            assert(status[i] == InverseStatus::Singular);
+            assert(inverses[i].eigen().isZero());
+            bool threw = false;
+            try {
+                matrices[i].inverse();
+            } catch (const std::runtime_error&) {
+                threw = true;
+            }
+            assert(threw);
+        } else {
+            assert(status[i] == InverseStatus::Ok);
+            assert(inverses[i].eigen().isApprox(matrices[i].inverse().eigen(), 1e-12));
+        }
+    }
+    assert(singular == expectedSingular);
+
+    // Results do not depend on the thread count
+    ThreadPool serial(1);
+    std::vector<Matrix3x3> serialInverses(matrices.size());
+    std::vector<InverseStatus> serialStatus(matrices.size());
+    assert(inverseBatch(matrices, serialInverses, serialStatus, serial) == singular);
+    for (std::size_t i = 0; i < matrices.size(); ++i) {
+        assert(serialStatus[i] == status[i]);
+        assert(serialInverses[i].eigen() == inverses[i].eigen());
+    }
+
+    // In place
+    std::vector<Matrix3x3> inPlace = matrices;
+    inverseBatch(inPlace, inPlace, status, pool);
+    for (std::size_t i = 0; i < matrices.size(); ++i) {
+        assert(inPlace[i].eigen() == inverses[i].eigen());
+    }
+
+    std::cout << "✓ Batch/scalar equivalence tests passed\n";
+}
+
+void test_float_batch() {
+    std::cout << "Testing single-precision batch...\n";
+
+    std::vector<Matrix3x3f> matrices;
+    for (const Matrix3x3& m : makeMatrices(5000)) {
+        matrices.push_back(m.cast<float>());
+    }
+    std::vector<Matrix3x3f> inverses(matrices.size());
+    std::vector<InverseStatus> status(matrices.size());
+    std::vector<float> dets(matrices.size());
+
+    const std::size_t singular = inverseBatch(matrices, inverses, status, dets);
+    assert(singular == 5);
+    for (std::size_t i = 0; i < matrices.size(); ++i) {
+        if (status[i] == InverseStatus::Ok) {
+            Matrix3x3f product = matrices[i] * inverses[i];
+            assert(product.eigen().isApprox(Eigen::Matrix3f::Identity(), 1e-5f));
+        }
+    }
+
+    std::cout << "✓ Single-precision batch tests passed\n";
+}
+
+void test_batch_errors() {
+    std::cout << "Testing batch error handling...\n";
+
+    std::vector<Matrix3x3> matrices(10, Matrix3x3::identity());
+    std::vector<Matrix3x3> out(10);
+    std::vector<InverseStatus> shortStatus(9);
+    std::vector<double> shortDets(9);
+
+    bool threw = false;
+    try {
+        inverseBatch(matrices, out, shortStatus);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        determinantBatch(matrices, shortDets);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✓ Batch error handling tests passed\n";
+}
+
+int main() {
+    std::cout << "Running Matrix Batch Tests\n";
+    std::cout << "=========================\n";
+
+    test_thread_pool();
+    test_batch_matches_scalar();
+    test_float_batch();
+    test_batch_errors();
+
+    std::cout << "\n✓ All matrix batch tests passed!\n";
+    return 0;
+}
@@ -2,9 +2,17 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 using namespace math_utils;
 
+// Results built from temporaries are evaluated, never left referencing them
+static_assert(std::is_same_v<decltype(Matrix3x3().inverse() * Vector3()), Vector3>);
+static_assert(std::is_same_v<decltype(Matrix3x3::identity() * 2.0), Matrix3x3>);
+static_assert(std::is_same_v<decltype(Matrix3x3::identity().transpose()), Matrix3x3>);
+
 void test_matrix_construction() {
     std::cout << "Testing matrix construction...\n";
     
@@ -89,6 +97,161 @@ void test_matrix_transpose() {
     std::cout << "✓ Matrix transpose tests passed\n";
 }
 
+void test_matrix_expressions() {
+    std::cout << "Testing fused matrix expressions...\n";
+    
+    Matrix3x3 m1({{{1, 2, 3}, {4, 5, 6}, {7, 8, 10}}});
+    Matrix3x3 m2({{{0.5, 0, -1}, {2, 1, 0}, {0, -3, 1}}});
+    Vector3 v(1.0, -1.0, 2.0);
+    
+    Matrix3x3 product = m1 * m2;
+    Vector3 expected = product * v;
+    Vector3 fused = m1 * m2 * v;
+    assert((fused - expected).magnitude() < 1e-12);
+    
+    Matrix3x3 combined = (m1 + m2.transpose()) * 2.0 - m2;
+    Matrix3x3 transposed = m2.transpose();
+    Matrix3x3 sum = m1 + transposed;
+    Matrix3x3 stepwise = sum * 2.0 - m2;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            assert(std::abs(combined(i, j) - stepwise(i, j)) < 1e-12);
+        }
+    }
+    
+    // Transformed point plus translation in one pass
+    Vector3 t(1.0, 2.0, 3.0);
+    Vector3 moved = m1 * v + t;
+    assert(std::abs(moved.x() - (1.0 - 2.0 + 6.0 + 1.0)) < 1e-12);
+    
+    // Assigning an expression that reads the target is alias-safe
+    Matrix3x3 m3 = m1;
+    m3 = m3.transpose();
+    assert(m3(0, 1) == 4.0 && m3(1, 0) == 2.0);
+    
+    std::cout << "✓ Fused matrix expression tests passed\n";
+}
+
+void test_matrix_expression_api() {
+    std::cout << "Testing the Matrix3x3 API on expressions...\n";
+    
+    Matrix3x3 m1({{{2, 1, 0}, {1, 3, 1}, {0, 1, 4}}});
+    Matrix3x3 m2({{{1, 0, 2}, {0, 1, 0}, {-1, 0, 1}}});
+    const Matrix3x3 product = m1 * m2;
+    const Matrix3x3 sum = m1 + m2;
+    
+    // Calls written against the eager Matrix3x3 operators keep compiling
+    assert((m1 * m2).determinant() == product.determinant());
+    assert((m1 * m2)(0, 0) == product(0, 0) && (m1 * m2)(2, 1) == product(2, 1));
+    assert(((m1 + m2).inverse() - sum.inverse()).norm() == 0.0);
+    assert(((m1 * m2).transpose() - product.transpose()).norm() == 0.0);
+    assert((m1 + m1.transpose()).isSymmetric());
+    assert(((m1 * 2.0).eigenvalues() - (m1 * 2.0).eval().eigenvalues()).norm() == 0.0);
+    assert(((m1 + m1).symmetricEigen().eigenvalues - (m1 * 2.0).eval().symmetricEigen().eigenvalues).norm() < 1e-12);
+    
+    bool threw = false;
+    try {
+        (m1 * m2)(3, 0);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw == (MATH_UTILS_BOUNDS_CHECK != 0));
+    
+    // A product with a temporary inverse is evaluated before the inverse dies
+    Vector3 v(1.0, -2.0, 0.5);
+    auto solved = m1.inverse() * v;
+    Matrix3x3 scratch = Matrix3x3::identity() * 7.0;
+    assert(((m1 * solved) - v).magnitude() < 1e-12 && scratch(0, 0) == 7.0);
+    
+    std::cout << "✓ Matrix expression API tests passed\n";
+}
+
+void test_matrix_element_access() {
+    std::cout << "Testing matrix element access...\n";
+    
+    Matrix3x3 m({{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}});
+    assert(m.at_unchecked(1, 2) == m(1, 2));
+    m.at_unchecked(2, 0) = 42.0;
+    assert(m(2, 0) == 42.0);
+    
+    // data() exposes column-major storage
+    const double* raw = m.data();
+    assert(raw[0] == 1.0 && raw[1] == 4.0 && raw[3] == 2.0 && raw[2] == 42.0);
+    
+#if MATH_UTILS_BOUNDS_CHECK
+    bool threw = false;
+    try {
+        (void)m(3, 0);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+#endif
+    
+    std::cout << "✓ Matrix element access tests passed\n";
+}
+
+void test_symmetric_eigen() {
+    std::cout << "Testing symmetric eigen decomposition...\n";
+    
+    Matrix3x3 m({{{4, 1, -2}, {1, 2, 0}, {-2, 0, 3}}});
+    assert(m.isSymmetric());
+    
+    SymmetricEigenDecomposition eig = m.symmetricEigen();
+    assert(eig.eigenvalues(0) <= eig.eigenvalues(1) && eig.eigenvalues(1) <= eig.eigenvalues(2));
+    assert(std::abs(eig.eigenvalues.sum() - m.trace()) < 1e-10);
+    
+    // Each column satisfies m * v = lambda * v with unit length
+    for (int k = 0; k < 3; ++k) {
+        Vector3 v(eig.eigenvectors(0, k), eig.eigenvectors(1, k), eig.eigenvectors(2, k));
+        Vector3 residual = m * v - v * eig.eigenvalues(k);
+        assert(residual.magnitude() < 1e-10);
+        assert(std::abs(v.magnitude() - 1.0) < 1e-10);
+    }
+    
+    // eigenvalues() takes the same fast path for symmetric input
+    Eigen::Vector3d values = m.eigenvalues();
+    assert((values - eig.eigenvalues).norm() < 1e-12);
+    
+    // Non-symmetric input keeps using the general solver
+    Matrix3x3 upper({{{1, 5, 0}, {0, 2, 7}, {0, 0, 3}}});
+    assert(!upper.isSymmetric());
+    Eigen::Vector3d general = upper.eigenvalues();
+    assert(std::abs(general.sum() - 6.0) < 1e-10);
+    
+    bool threw = false;
+    try {
+        (void)upper.symmetricEigen();
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Batched decomposition matches the single-matrix API
+    std::vector<Matrix3x3> batch = { m, Matrix3x3::identity() * 2.0, m * m };
+    std::vector<SymmetricEigenDecomposition> results(batch.size());
+    symmetricEigenBatch(batch, results);
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        assert((results[i].eigenvalues - batch[i].symmetricEigen().eigenvalues).norm() < 1e-12);
+    }
+    assert(std::abs(results[1].eigenvalues(0) - 2.0) < 1e-12);
+    
+    // A batch with a non-symmetric matrix is rejected before any output is written
+    std::vector<Matrix3x3> mixed = { m, upper };
+    std::vector<SymmetricEigenDecomposition> untouched(mixed.size());
+    untouched[0].eigenvalues.setConstant(-1.0);
+    threw = false;
+    try {
+        symmetricEigenBatch(mixed, untouched);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    assert((untouched[0].eigenvalues.array() == -1.0).all());
+    
+    std::cout << "✓ Symmetric eigen decomposition tests passed\n";
+}
+
 int main() {
     std::cout << "Running Matrix Tests\n";
     std::cout << "===================\n";
@@ -97,6 +260,10 @@ int main() {
     test_matrix_operations();
     test_matrix_determinant_and_inverse();
     test_matrix_transpose();
+    test_matrix_expressions();
+    test_matrix_expression_api();
+    test_matrix_element_access();
+    test_symmetric_eigen();
     
     std::cout << "\n✓ All matrix tests passed!\n";
     return 0;
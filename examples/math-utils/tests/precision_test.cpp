@@ -0,0 +1,166 @@
+#include "math-utils/matrix.hpp"
+#include "math-utils/vector.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+using namespace math_utils;
+
+namespace {
+
+// Checked with expect() rather than assert so release builds still run them
+void expect(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << "\n";
+        std::abort();
+    }
+}
+
+} // namespace
+
+// Precision changes must be spelled out
+static_assert(std::is_constructible_v<Vector3f, Vector3>);
+static_assert(std::is_constructible_v<Vector3, Vector3f>);
+static_assert(!std::is_convertible_v<Vector3, Vector3f>);
+static_assert(!std::is_convertible_v<Vector3f, Vector3>);
+static_assert(std::is_constructible_v<Matrix3x3f, Matrix3x3>);
+static_assert(!std::is_convertible_v<Matrix3x3, Matrix3x3f>);
+static_assert(!std::is_convertible_v<Matrix3x3f, Matrix3x3>);
+
+// Mixed-precision arithmetic does not compile
+template <typename L, typename R>
+concept Addable = requires(const L& lhs, const R& rhs) { lhs + rhs; };
+template <typename L, typename R>
+concept Multipliable = requires(const L& lhs, const R& rhs) { lhs * rhs; };
+
+static_assert(Addable<Vector3f, Vector3f>);
+static_assert(!Addable<Vector3f, Vector3>);
+static_assert(!Addable<Matrix3x3, Matrix3x3f>);
+static_assert(Multipliable<Matrix3x3f, Vector3f>);
+static_assert(!Multipliable<Matrix3x3f, Vector3>);
+
+// Single precision keeps the compact layout
+static_assert(sizeof(Vector3f) == 3 * sizeof(float));
+static_assert(sizeof(Matrix3x3f) == 9 * sizeof(float));
+
+void test_float_vector() {
+    std::cout << "Testing single-precision vectors...\n";
+
+    Vector3f v1(1.0f, 2.0f, 3.0f);
+    Vector3f v2(4.0f, 5.0f, 6.0f);
+
+    Vector3f fused = (v1 + v2) * 2.0f - v1;
+    expect(fused.x() == 9.0f && fused.y() == 12.0f && fused.z() == 15.0f, "fused float expression");
+
+    static_assert(std::is_same_v<decltype(v1.dot(v2)), float>);
+    expect(v1.dot(v2) == 32.0f, "float dot");
+
+    Vector3f cross = v1.cross(v2);
+    expect(cross.x() == -3.0f && cross.y() == 6.0f && cross.z() == -3.0f, "float cross");
+
+    Vector3f unit = Vector3f(3.0f, 4.0f, 0.0f).normalized();
+    expect(std::abs(unit.magnitude() - 1.0f) < 1e-6f, "float normalized");
+
+    std::ostringstream out;
+    out << v1;
+    expect(out.str() == "Vector3f(1, 2, 3)", "Vector3f output");
+
+    std::cout << "✓ Single-precision vector tests passed\n";
+}
+
+void test_explicit_conversion() {
+    std::cout << "Testing explicit precision conversion...\n";
+
+    Vector3 d(0.1, 0.2, 0.3);
+    Vector3f f = d.cast<float>();
+    expect(f.x() == 0.1f && f.y() == 0.2f && f.z() == 0.3f, "vector cast to float");
+
+    Vector3 back(f);
+    expect(back.x() == static_cast<double>(0.1f), "vector conversion to double");
+
+    Matrix3x3 m = Matrix3x3::identity() * 2.0;
+    Matrix3x3f mf(m);
+    expect(mf(0, 0) == 2.0f && mf(0, 1) == 0.0f, "matrix conversion to float");
+    expect(mf.cast<double>()(2, 2) == 2.0, "matrix cast to double");
+
+    // Expressions convert after evaluation
+    Vector3f fromExpr = (d + d).eval().cast<float>();
+    expect(fromExpr.x() == 0.2f, "expression cast to float");
+
+    std::cout << "✓ Explicit conversion tests passed\n";
+}
+
+void test_mixed_precision_accumulation() {
+    std::cout << "Testing higher-precision accumulation...\n";
+
+    // 1e8 + 1 is not representable in float, so float accumulation of this
+    // dot product depends on evaluation order; double accumulation is exact
+    Vector3f big(1e8f, 1.0f, -1e8f);
+    Vector3f ones(1.0f, 1.0f, 1.0f);
+    static_assert(std::is_same_v<decltype(big.dot<double>(ones)), double>);
+    expect(big.dot<double>(ones) == 1.0, "double accumulation of float dot");
+
+    // The squared norm of this vector overflows float but not double
+    Vector3f large(3e20f, 4e20f, 0.0f);
+    const double magnitude = large.magnitude<double>();
+    expect(std::abs(magnitude - 5e20) < 5e20 * 1e-6, "double accumulation of float magnitude");
+    expect(std::isfinite(large.squaredNorm<double>()), "double accumulation of float squaredNorm");
+
+    // Lazy expressions accumulate the same way
+    expect(std::abs((large + large).magnitude<double>() - 1e21) < 1e21 * 1e-6, "double accumulation of an expression");
+
+    // Default accumulation matches the double API exactly
+    Vector3 d1(1.0, 2.0, 3.0), d2(4.0, 5.0, 6.0);
+    expect(d1.dot(d2) == d1.dot<double>(d2), "default dot accumulation");
+    expect(d1.magnitude() == std::sqrt(14.0), "default magnitude accumulation");
+
+    std::cout << "✓ Higher-precision accumulation tests passed\n";
+}
+
+void test_float_matrix() {
+    std::cout << "Testing single-precision matrices...\n";
+
+    Matrix3x3f m({{{2.0f, 1.0f, 0.0f}, {1.0f, 3.0f, 1.0f}, {0.0f, 1.0f, 4.0f}}});
+    expect(m.isSymmetric(), "float isSymmetric");
+    expect(std::abs(m.determinant() - 18.0f) < 1e-4f, "float determinant");
+
+    Matrix3x3f product = m * m.inverse();
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            expect(std::abs(product(i, j) - (i == j ? 1.0f : 0.0f)) < 1e-5f, "float inverse");
+        }
+    }
+
+    Vector3f transformed = m * Vector3f(1.0f, 0.0f, 0.0f);
+    expect(transformed.x() == 2.0f && transformed.y() == 1.0f && transformed.z() == 0.0f, "float matrix * vector");
+
+    // Single-precision eigen decomposition agrees with double precision
+    SymmetricEigenDecompositionf eig = m.symmetricEigen();
+    Eigen::Vector3d expected = m.cast<double>().eigenvalues();
+    for (int i = 0; i < 3; ++i) {
+        expect(std::abs(eig.eigenvalues(i) - expected(i)) < 1e-4, "float symmetric eigenvalues");
+    }
+
+    std::vector<Matrix3x3f> batch(4, m);
+    std::vector<SymmetricEigenDecompositionf> results(batch.size());
+    symmetricEigenBatch(batch, results);
+    expect(results[3].eigenvalues.isApprox(eig.eigenvalues), "float symmetric eigen batch");
+
+    std::cout << "✓ Single-precision matrix tests passed\n";
+}
+
+int main() {
+    std::cout << "Running Precision Tests\n";
+    std::cout << "======================\n";
+
+    test_float_vector();
+    test_explicit_conversion();
+    test_mixed_precision_accumulation();
+    test_float_matrix();
+
+    std::cout << "\n✓ All precision tests passed!\n";
+    return 0;
+}
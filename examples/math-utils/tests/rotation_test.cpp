@@ -0,0 +1,214 @@
+#include "math-utils/rotation.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <numbers>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using namespace math_utils;
+
+static_assert(!std::is_convertible_v<Rotation, Rotationf>);
+static_assert(std::is_constructible_v<Rotationf, Rotation>);
+static_assert(!std::is_convertible_v<RigidTransformf, RigidTransform>);
+static_assert(!std::is_convertible_v<Matrix3x3, Rotation>);
+
+namespace {
+
+// Checked with expect() rather than assert so release builds still run them
+void expect(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << "\n";
+        std::abort();
+    }
+}
+
+bool close(const Vector3& a, const Vector3& b, double tolerance = 1e-12) {
+    return (a - b).magnitude() <= tolerance * std::max(1.0, b.magnitude());
+}
+
+bool close(const Matrix3x3& a, const Matrix3x3& b, double tolerance = 1e-12) {
+    return (a - b).norm() <= tolerance;
+}
+
+std::vector<Vector3> makePoints(std::size_t count) {
+    std::vector<Vector3> points;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double s = static_cast<double>(i);
+        points.emplace_back(std::sin(s) * 10.0, std::cos(s * 0.7) - 2.0, s * 0.001);
+    }
+    return points;
+}
+
+} // namespace
+
+void test_rotation_basics() {
+    std::cout << "Testing rotation construction and apply...\n";
+
+    const double pi = std::numbers::pi;
+    Rotation quarter = Rotation::fromAxisAngle(Vector3(0.0, 0.0, 2.0), pi / 2);
+    expect(close(quarter.apply(Vector3(1.0, 0.0, 0.0)), Vector3(0.0, 1.0, 0.0)), "quarter turn applies to x");
+    expect(close(quarter * Vector3(0.0, 1.0, 0.0), Vector3(-1.0, 0.0, 0.0)), "operator* applies the rotation");
+    expect(std::abs(quarter.angle() - pi / 2) < 1e-12, "axis-angle angle");
+
+    // Quaternions are normalized on construction
+    Rotation scaled = Rotation::fromQuaternion(2.0, 0.0, 0.0, 0.0);
+    expect(scaled.w() == 1.0 && scaled.angle() == 0.0, "fromQuaternion normalizes");
+
+    bool threw = false;
+    try {
+        Rotation::fromQuaternion(0.0, 0.0, 0.0, 0.0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw, "zero quaternion throws");
+
+    std::cout << "✓ Rotation construction tests passed\n";
+}
+
+void test_matrix_conversion() {
+    std::cout << "Testing conversion to and from Matrix3x3...\n";
+
+    Rotation r = Rotation::fromAxisAngle(Vector3(1.0, -2.0, 0.5), 0.83);
+    Matrix3x3 m = r.toMatrix();
+    expect(std::abs(m.determinant() - 1.0) < 1e-12, "toMatrix determinant");
+    expect(close(m * m.transpose(), Matrix3x3::identity()), "toMatrix is orthonormal");
+
+    const Vector3 p(0.3, -1.2, 4.0);
+    expect(close(m * p, r.apply(p)), "toMatrix applies like the rotation");
+    expect(Rotation::fromMatrix(m).angularDistance(r) < 1e-12, "fromMatrix round trip");
+
+    // A slightly drifted matrix maps to the nearby rotation
+    Matrix3x3 drifted = m * (1.0 + 1e-9);
+    expect(Rotation::fromMatrix(drifted).angularDistance(r) < 1e-8, "fromMatrix of a drifted matrix");
+
+    bool threw = false;
+    try {
+        Rotation::fromMatrix(Matrix3x3({{{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, -1.0}}}));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw, "reflection throws");
+
+    std::cout << "✓ Matrix conversion tests passed\n";
+}
+
+void test_compose_and_inverse() {
+    std::cout << "Testing composition and inverse...\n";
+
+    Rotation a = Rotation::fromAxisAngle(Vector3(0.2, 1.0, -0.3), 1.1);
+    Rotation b = Rotation::fromAxisAngle(Vector3(-1.0, 0.4, 0.9), -0.6);
+    const Vector3 p(1.5, -0.25, 2.0);
+
+    expect(close((a * b).apply(p), a.apply(b.apply(p))), "composed apply");
+    expect(close((a * b).toMatrix(), Matrix3x3(a.toMatrix() * b.toMatrix())), "composed toMatrix");
+    expect(close(a.inverse().apply(a.apply(p)), p), "inverse apply");
+    expect((a * a.inverse()).angle() < 1e-12, "rotation times inverse");
+
+    RigidTransform ta(a, Vector3(1.0, 2.0, 3.0));
+    RigidTransform tb(b, Vector3(-0.5, 0.0, 4.0));
+    expect(close((ta * tb).apply(p), ta.apply(tb.apply(p))), "composed rigid transform");
+    expect(close(ta.inverse().apply(ta.apply(p)), p), "rigid transform inverse");
+    expect(close((ta * ta.inverse()).translation(), Vector3(), 1e-12), "rigid transform times inverse");
+
+    // Precision conversions are explicit
+    Rotationf af = a.cast<float>();
+    RigidTransformf taf(ta);
+    expect(std::abs(af.w() - static_cast<float>(a.w())) < 1e-7f, "Rotation cast to float");
+    expect(close(Vector3(taf.apply(p.cast<float>())), ta.apply(p), 1e-5), "RigidTransform cast to float");
+
+    std::cout << "✓ Composition and inverse tests passed\n";
+}
+
+void test_long_chains_stay_unit() {
+    std::cout << "Testing drift over long rotation chains...\n";
+
+    // A million compositions keep the quaternion unit length to rounding
+    const Rotation step = Rotation::fromAxisAngle(Vector3(0.3, -0.5, 0.8), 1e-3);
+    Rotation chain;
+    Matrix3x3 matrixChain = Matrix3x3::identity();
+    const Matrix3x3 matrixStep = step.toMatrix();
+    for (int i = 0; i < 1000000; ++i) {
+        chain = chain * step;
+        if (i < 1000) {
+            matrixChain = matrixChain * matrixStep;
+        }
+    }
+    expect(std::abs(chain.eigen().norm() - 1.0) < 1e-14, "chain stays unit length");
+    Matrix3x3 m = chain.toMatrix();
+    expect(close(m * m.transpose(), Matrix3x3::identity(), 1e-14), "chain matrix is orthonormal");
+
+    // The same rotation, one composition at a time, agrees with the matrix chain
+    Rotation shortChain;
+    for (int i = 0; i < 1000; ++i) {
+        shortChain = shortChain * step;
+    }
+    expect(close(shortChain.toMatrix(), matrixChain, 1e-11), "chain matches the matrix chain");
+
+    std::cout << "✓ Long chain tests passed\n";
+}
+
+void test_batched_apply() {
+    std::cout << "Testing batched apply against per-point apply...\n";
+
+    const RigidTransform transform(Rotation::fromAxisAngle(Vector3(1.0, 1.0, 0.0), 0.4), Vector3(3.0, -1.0, 0.5));
+    const std::vector<Vector3> points = makePoints(1001);
+
+    std::vector<Vector3> out(points.size());
+    transformPoints(transform, points, out);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        expect(close(out[i], transform.apply(points[i])), "batched apply");
+    }
+
+    std::vector<Vector3> inPlace = points;
+    transformPointsInPlace(transform, inPlace);
+    Vector3Batch batch(points);
+    transformPointsInPlace(transform, batch);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        expect(close(inPlace[i], out[i]), "in-place apply");
+        expect(close(batch[i], out[i]), "in-place batch apply");
+    }
+
+    // Rotations convert to rigid transforms with no translation
+    transformPoints(transform.rotation(), points, out);
+    expect(close(out[7], transform.rotation().apply(points[7])), "rotation as a rigid transform");
+
+    std::vector<Vector3f> pointsf;
+    for (const Vector3& p : points) {
+        pointsf.push_back(p.cast<float>());
+    }
+    const RigidTransformf transformf = transform.cast<float>();
+    std::vector<Vector3f> outf(pointsf.size());
+    transformPoints(transformf, pointsf, outf);
+    transformPointsInPlace(transformf, pointsf);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        expect(close(Vector3(outf[i]), transform.apply(points[i]), 1e-5), "float batched apply");
+        expect(close(Vector3(pointsf[i]), Vector3(outf[i]), 1e-6), "float in-place apply");
+    }
+
+    bool threw = false;
+    try {
+        std::vector<Vector3> shortOut(3);
+        transformPoints(transform, points, shortOut);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw, "size mismatch throws");
+
+    std::cout << "✓ Batched apply tests passed\n";
+}
+
+int main() {
+    std::cout << "Running Rotation Tests\n";
+    std::cout << "=====================\n";
+
+    test_rotation_basics();
+    test_matrix_conversion();
+    test_compose_and_inverse();
+    test_long_chains_stay_unit();
+    test_batched_apply();
+
+    std::cout << "\n✓ All rotation tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include "math-utils/transform.hpp"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace math_utils;
+
+namespace {
+
+std::vector<Vector3> sample_points(std::size_t count) {
+    std::vector<Vector3> points;
+    points.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const double t = static_cast<double>(i);
+        points.emplace_back(std::cos(0.1 * t) * t, std::sin(0.2 * t) - 1.0, 0.01 * t * t);
+    }
+    return points;
+}
+
+bool close(const Vector3& a, const Vector3& b) {
+    return (a - b).magnitude() <= 1e-9 * std::max(1.0, b.magnitude());
+}
+
+const SimdLevel kAllLevels[] = { SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512 };
+
+} // namespace
+
+void test_transform_matches_per_point() {
+    std::cout << "Testing batched transform against per-point multiply...\n";
+
+    Matrix3x3 m({{{0.0, -1.0, 0.5}, {1.0, 0.25, 0.0}, {-0.5, 0.0, 2.0}}});
+    Vector3 translation(1.0, -2.0, 3.0);
+    // 531 points exercises full SIMD lanes, block boundaries and scalar tails
+    auto points = sample_points(531);
+
+    for (SimdLevel level : kAllLevels) {
+        if (!simdLevelSupported(level)) {
+            continue;
+        }
+        setSimdLevel(level);
+
+        std::vector<Vector3> out(points.size());
+        transformPoints(m, points, out, translation);
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            assert(close(out[i], m * points[i] + translation));
+        }
+
+        auto inPlace = points;
+        transformPointsInPlace(m, inPlace);
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            assert(close(inPlace[i], m * points[i]));
+        }
+
+        Vector3Batch batch(points);
+        Vector3Batch batchOut;
+        transformPoints(m, batch, batchOut, translation);
+        assert(batchOut.size() == points.size());
+        transformPointsInPlace(m, batch);
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            assert(close(batchOut[i], m * points[i] + translation));
+            assert(close(batch[i], m * points[i]));
+        }
+        std::cout << "  " << simdLevelName(level) << " kernel ok\n";
+    }
+
+    std::cout << "✓ Batched transform tests passed\n";
+}
+
+void test_transform_rounding_is_position_independent() {
+    std::cout << "Testing every lane and tail point rounds the same way...\n";
+
+    Matrix3x3 m({{{1.0 / 3.0, 0.1, -0.7}, {0.3, 2.0 / 7.0, 0.9}, {-0.2, 0.6, 1.0 / 9.0}}});
+    Vector3 translation(0.1, -0.3, 0.7);
+    // 13 copies of one point: full vectors of 4 and 8 plus a tail at each width
+    std::vector<Vector3> points(13, Vector3(0.1, 0.2, 0.3));
+
+    for (SimdLevel level : kAllLevels) {
+        if (!simdLevelSupported(level)) {
+            continue;
+        }
+        setSimdLevel(level);
+
+        std::vector<Vector3> out(points.size());
+        transformPoints(m, points, out, translation);
+        Vector3Batch batchOut;
+        transformPoints(m, Vector3Batch(points), batchOut, translation);
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            assert(out[i].x() == out[0].x() && out[i].y() == out[0].y() && out[i].z() == out[0].z());
+            assert(batchOut[i].x() == out[0].x() && batchOut[i].y() == out[0].y() &&
+                   batchOut[i].z() == out[0].z());
+        }
+    }
+
+    std::cout << "✓ Position-independent rounding tests passed\n";
+}
+
+void test_transform_errors() {
+    std::cout << "Testing batched transform error handling...\n";
+
+    std::vector<Vector3> in(4);
+    std::vector<Vector3> out(3);
+    [[maybe_unused]] bool threw = false;
+    try {
+        transformPoints(Matrix3x3::identity(), in, out);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::vector<Vector3> empty;
+    transformPointsInPlace(Matrix3x3::identity(), empty);
+
+    std::cout << "✓ Batched transform error handling tests passed\n";
+}
+
+int main() {
+    std::cout << "Running Transform Tests\n";
+    std::cout << "======================\n";
+
+    test_transform_matches_per_point();
+    test_transform_rounding_is_position_independent();
+    test_transform_errors();
+
+    std::cout << "\n✓ All transform tests passed!\n";
+    return 0;
+}
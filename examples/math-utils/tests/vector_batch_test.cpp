@@ -0,0 +1,187 @@
+#include "math-utils/vector_batch.hpp"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace math_utils;
+
+namespace {
+
+std::vector<Vector3> sample_vectors() {
+    std::vector<Vector3> vectors;
+    for (int i = 0; i < 37; ++i) {
+        vectors.emplace_back(0.5 * i - 3.0, std::sin(0.3 * i) + 1.5, 2.0 - 0.125 * i * i);
+    }
+    return vectors;
+}
+
+bool same(const Vector3& a, const Vector3& b) {
+    return a.x() == b.x() && a.y() == b.y() && a.z() == b.z();
+}
+
+// Results that sum several products may be ordered or contracted into fused
+// multiply-adds differently in the batch and scalar code paths. They are
+// compared to within 4 eps of `scale`, the bound documented in
+// vector_batch.hpp.
+bool within(double a, double b, double scale) {
+    return std::abs(a - b) <= 4.0 * std::numeric_limits<double>::epsilon() * scale;
+}
+
+bool within(const Vector3& a, const Vector3& b, const Vector3& scale) {
+    return within(a.x(), b.x(), scale.x()) && within(a.y(), b.y(), scale.y()) && within(a.z(), b.z(), scale.z());
+}
+
+double dotScale(const Vector3& a, const Vector3& b) {
+    return a.eigen().cwiseProduct(b.eigen()).cwiseAbs().sum();
+}
+
+Vector3 crossScale(const Vector3& a, const Vector3& b) {
+    return Vector3(std::abs(a.y() * b.z()) + std::abs(a.z() * b.y()),
+                   std::abs(a.z() * b.x()) + std::abs(a.x() * b.z()),
+                   std::abs(a.x() * b.y()) + std::abs(a.y() * b.x()));
+}
+
+} // namespace
+
+void test_batch_construction() {
+    std::cout << "Testing batch construction...\n";
+
+    Vector3Batch empty;
+    assert(empty.empty() && empty.size() == 0);
+
+    Vector3Batch zeros(4);
+    assert(zeros.size() == 4);
+    assert(same(zeros[3], Vector3()));
+
+    auto vectors = sample_vectors();
+    Vector3Batch batch(vectors);
+    assert(batch.size() == vectors.size());
+    for (std::size_t i = 0; i < vectors.size(); ++i) {
+        assert(same(batch[i], vectors[i]));
+    }
+
+    auto roundTrip = batch.toVectors();
+    assert(roundTrip.size() == vectors.size());
+    assert(same(roundTrip[10], vectors[10]));
+
+    batch.set(2, Vector3(7.0, 8.0, 9.0));
+    assert(same(batch[2], Vector3(7.0, 8.0, 9.0)));
+
+    std::cout << "✓ Batch construction tests passed\n";
+}
+
+void test_batch_matches_scalar() {
+    std::cout << "Testing batch operations against scalar API...\n";
+
+    auto a = sample_vectors();
+    auto b = sample_vectors();
+    for (auto& v : b) {
+        v = v * -0.75 + Vector3(1.0, -2.0, 0.5);
+    }
+    Vector3Batch batchA(a);
+    Vector3Batch batchB(b);
+
+    Vector3Batch sum = batchA + batchB;
+    Vector3Batch diff = batchA - batchB;
+    Vector3Batch scaled = batchA * 2.5;
+    Vector3Batch shifted = batchA + Vector3(1.0, 2.0, 3.0);
+    Vector3Batch cross = batchA.cross(batchB);
+    Vector3Batch product = batchA.cwiseProduct(batchB);
+    Vector3Batch unit = batchA.normalized();
+    Eigen::ArrayXd dot = batchA.dot(batchB);
+    Eigen::ArrayXd squared = batchA.squaredNorm();
+    Eigen::ArrayXd magnitude = batchA.magnitude();
+
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        [[maybe_unused]] const auto k = static_cast<Eigen::Index>(i);
+        assert(same(sum[i], a[i] + b[i]));
+        assert(same(diff[i], a[i] - b[i]));
+        assert(same(scaled[i], a[i] * 2.5));
+        assert(same(shifted[i], a[i] + Vector3(1.0, 2.0, 3.0)));
+        assert(same(product[i], a[i].cwiseProduct(b[i])));
+        assert(within(cross[i], a[i].cross(b[i]), crossScale(a[i], b[i])));
+        assert(within(unit[i], a[i].normalized(), Vector3(1.0, 1.0, 1.0)));
+        assert(within(dot(k), a[i].dot(b[i]), dotScale(a[i], b[i])));
+        assert(within(squared(k), a[i].squaredNorm(), a[i].squaredNorm()));
+        assert(within(magnitude(k), a[i].magnitude(), a[i].magnitude()));
+    }
+
+    std::cout << "✓ Batch/scalar equivalence tests passed\n";
+}
+
+void test_batch_cancellation() {
+    std::cout << "Testing batch dot/cross with nearly cancelling terms...\n";
+
+    // Products around 1e16 whose sums are orders of magnitude smaller, so
+    // the rounding of each product dominates the result
+    std::vector<Vector3> a;
+    std::vector<Vector3> b;
+    for (int i = 0; i < 16; ++i) {
+        const double big = 1e8 + 0.37 * i;
+        a.emplace_back(big, big + 1.0 / 3.0, 0.1 * i);
+        b.emplace_back(big + 1.0 / 7.0, -big, big - 0.3);
+    }
+    Vector3Batch batchA(a);
+    Vector3Batch batchB(b);
+    Eigen::ArrayXd dot = batchA.dot(batchB);
+    Vector3Batch cross = batchA.cross(batchB);
+
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        [[maybe_unused]] const double scalar = a[i].dot(b[i]);
+        assert(std::abs(scalar) < 1e-6 * dotScale(a[i], b[i]));
+        assert(within(dot(static_cast<Eigen::Index>(i)), scalar, dotScale(a[i], b[i])));
+        assert(within(cross[i], a[i].cross(b[i]), crossScale(a[i], b[i])));
+    }
+
+    std::cout << "✓ Batch cancellation tests passed\n";
+}
+
+void test_batch_errors() {
+    std::cout << "Testing batch error handling...\n";
+
+    Vector3Batch three(3);
+    Vector3Batch four(4);
+
+    [[maybe_unused]] bool threw = false;
+    try {
+        (void)(three + four);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        (void)three.normalized();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        (void)three[3];
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✓ Batch error handling tests passed\n";
+}
+
+int main() {
+    std::cout << "Running Vector Batch Tests\n";
+    std::cout << "=========================\n";
+
+    test_batch_construction();
+    test_batch_matches_scalar();
+    test_batch_cancellation();
+    test_batch_errors();
+
+    std::cout << "\n✓ All vector batch tests passed!\n";
+    return 0;
+}
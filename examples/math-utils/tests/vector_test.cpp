@@ -2,9 +2,15 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <type_traits>
 
 using namespace math_utils;
 
+// Results built from temporaries are evaluated, never left referencing them
+static_assert(std::is_same_v<decltype(Vector3() + Vector3()), Vector3>);
+static_assert(std::is_same_v<decltype(-Vector3()), Vector3>);
+static_assert(!std::is_same_v<decltype(std::declval<const Vector3&>() + std::declval<const Vector3&>()), Vector3>);
+
 void test_vector_construction() {
     std::cout << "Testing vector construction...\n";
     
@@ -14,6 +20,9 @@ void test_vector_construction() {
     Vector3 v2(1.0, 2.0, 3.0);
     assert(v2.x() == 1.0 && v2.y() == 2.0 && v2.z() == 3.0);
     
+    const double* raw = v2.data();
+    assert(raw[0] == 1.0 && raw[1] == 2.0 && raw[2] == 3.0);
+    
     std::cout << "✓ Vector construction tests passed\n";
 }
 
@@ -61,6 +70,59 @@ void test_vector_magnitude() {
     std::cout << "✓ Vector magnitude tests passed\n";
 }
 
+void test_vector_expressions() {
+    std::cout << "Testing fused vector expressions...\n";
+    
+    Vector3 v1(1.5, -2.0, 3.25);
+    Vector3 v2(0.1, 0.2, -0.3);
+    Vector3 v3(-4.0, 5.0, 0.5);
+    
+    // Step-by-step evaluation materializes every intermediate result
+    Vector3 sum = v1 + v2;
+    Vector3 scaled = sum * 2.0;
+    Vector3 expected = scaled - v3;
+    
+    Vector3 fused = (v1 + v2) * 2.0 - v3;
+    assert((fused - expected).magnitude() < 1e-12);
+    
+    Vector3 negated = -v1 + 0.5 * v2 / 2.0;
+    assert(std::abs(negated.x() - (-1.5 + 0.025)) < 1e-12);
+    
+    // Reductions work directly on expressions
+    assert(std::abs((v1 - v1).magnitude()) < 1e-12);
+    assert(std::abs((v1 + v2).squaredNorm() - sum.squaredNorm()) < 1e-12);
+    assert(std::abs(v1.dot(v2 + v3) - v1.dot(v2) - v1.dot(v3)) < 1e-12);
+    
+    Vector3 product = v1.cwiseProduct(v2 + v3);
+    assert(std::abs(product.z() - 3.25 * 0.2) < 1e-12);
+    
+    std::cout << "✓ Fused vector expression tests passed\n";
+}
+
+void test_expression_api() {
+    std::cout << "Testing the Vector3 API on expressions...\n";
+    
+    Vector3 a(1.0, 2.0, 3.0);
+    Vector3 b(0.5, -1.0, 2.0);
+    Vector3 c(-2.0, 0.0, 1.0);
+    const Vector3 diff = a - b;
+    
+    // Calls written against the eager Vector3 operators keep compiling
+    assert((a - b).dot(c) == diff.dot(c));
+    assert((a + b).x() == 1.5 && (a + b).y() == 1.0 && (a + b).z() == 5.0);
+    assert(((a - b).normalized() - diff.normalized()).magnitude() < 1e-15);
+    assert(((a - b).cross(c) - diff.cross(c)).magnitude() == 0.0);
+    assert(((a - b).cwiseProduct(c) - diff.cwiseProduct(c)).magnitude() == 0.0);
+    assert((a * 2.0).dot<long double>(c) == 2.0L * a.dot(c));
+    
+    // An expression over a temporary is safe to keep
+    auto kept = Vector3(1.0, 1.0, 1.0) * 2.0 + a;
+    Vector3 scratch(9.0, 9.0, 9.0);
+    assert(kept.x() == 3.0 && kept.z() == 5.0 && scratch.x() == 9.0);
+    
+    std::cout << "✓ Expression API tests passed\n";
+}
+
 int main() {
     std::cout << "Running Vector Tests\n";
     std::cout << "===================\n";
@@ -68,6 +130,8 @@ int main() {
     test_vector_construction();
     test_vector_operations();
     test_vector_magnitude();
+    test_vector_expressions();
+    test_expression_api();
     
     std::cout << "\n✓ All vector tests passed!\n";
     return 0;
@@ -1,27 +1,92 @@
 #include "math-utils/vector.hpp"
 #include "math-utils/matrix.hpp"
+#include "math-utils/batch_file.hpp"
 #include "logger/logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iostream>
-#include <format>
+#include <vector>
 
 using namespace math_utils;
 
-int main() {
+namespace {
+
+void printUsage() {
+    std::cerr << "Usage: calculator                                 Run the demo\n"
+              << "       calculator --batch <input> <output|-> [operation...]\n"
+              << "\n"
+              << "Streams a binary batch file of vectors or matrices (see math-utils/batch_file.hpp)\n"
+              << "through the operations in order and writes a batch file of the results.\n"
+              << "Operations:\n"
+              << "  transform:m00,m01,...,m22[,tx,ty,tz]   vectors -> vectors, p' = M p + t (M row-major)\n"
+              << "  normalize                               vectors -> unit vectors (zero stays zero)\n"
+              << "  determinant                             matrices -> scalars\n"
+              << "  eigenvalues                             matrices -> vectors\n";
+}
+
+int runBatchMode(int argc, char** argv) {
+    if (argc < 4) {
+        printUsage();
+        return 2;
+    }
+    const std::string input = argv[2];
+    const std::string output = argv[3];
+
+    // The console sink would interleave with binary output on stdout
+    logger::LoggerOptions options;
+    options.console = output != "-";
+    auto log = logger::CreateLogger(logger::LogLevel::Info, "MathCalculator", options);
+
+    try {
+        std::vector<BatchStep> steps;
+        for (int i = 4; i < argc; ++i) {
+            steps.push_back(parseBatchStep(argv[i]));
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const BatchResult result = runBatch(input, output, steps);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        LOG_INFO(log, "Processed {} elements through {} operations in {:.3f}s ({:.1f} MB/s written)",
+                 result.count, steps.size(), seconds, result.bytesWritten / 1e6 / std::max(seconds, 1e-9));
+        if (result.zeroVectors > 0) {
+            LOG_WARNING(log, "{} zero vectors could not be normalized and were written as zero", result.zeroVectors);
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR(log, "Batch failed: {}", e.what());
+        std::cerr << "calculator: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        if (std::strcmp(argv[1], "--batch") == 0) {
+            return runBatchMode(argc, argv);
+        }
+        printUsage();
+        return 2;
+    }
+    
     // Create a simple logger
     auto log = logger::CreateLogger(logger::LogLevel::Info, "MathCalculator");
     
-    log->info("Math Utils Calculator started");
+    LOG_INFO(log, "Math Utils Calculator started");
     
     std::cout << "Math Utils Calculator Demo\n";
     std::cout << "==========================\n\n";
     
     // Vector operations
-    log->info("Starting vector operations");
+    LOG_INFO(log, "Starting vector operations");
     std::cout << "Vector Operations:\n";
     Vector3 v1(1.0, 2.0, 3.0);
     Vector3 v2(4.0, 5.0, 6.0);
     
-    log->debug("Created vectors for demonstration");
+    LOG_DEBUG(log, "Created vectors for demonstration");
     
     std::cout << "v1 = " << v1 << "\n";
     std::cout << "v2 = " << v2 << "\n";
@@ -67,10 +132,17 @@ int main() {
         std::cout << "  λ2 = " << eigenvals(1) << "\n";
         std::cout << "  λ3 = " << eigenvals(2) << "\n";
     } catch (const std::exception& e) {
-        log->error(std::format("Error computing eigenvalues: {}", e.what()));
+        LOG_ERROR(log, "Error computing eigenvalues: {}", e.what());
         std::cout << "Error computing eigenvalues: " << e.what() << "\n";
     }
     
-    log->info("Math Utils Calculator completed successfully");
+    // Symmetric matrices take the closed-form eigen solver
+    Matrix3x3 symmetric = random + random.transpose();
+    SymmetricEigenDecomposition decomposition = symmetric.symmetricEigen();
+    std::cout << "\nSymmetric matrix (random + transpose):\n" << symmetric << "\n";
+    std::cout << "Eigenvalues (ascending): " << decomposition.eigenvalues.transpose() << "\n";
+    std::cout << "Eigenvectors (columns):\n" << decomposition.eigenvectors << "\n";
+    
+    LOG_INFO(log, "Math Utils Calculator completed successfully");
     return 0;
 }
@@ -17,12 +17,32 @@
         # Discover modules from examples directory
         moduleDiscovery = cmake-rules.discoverModules ./examples;
         
-        # Resolve module dependencies and build in proper order
-        modules = cmake-rules.resolveModuleDependencies moduleDiscovery pkgs cmake-rules;
-        
         # Global build configuration
         buildConfig = import ./examples/build-config.nix { inherit pkgs; };
         
+        # Resolve module dependencies and build in proper order, applying
+        # per-module overrides from build-config.nix
+        modules = cmake-rules.resolveModuleDependenciesWithConfig moduleDiscovery pkgs cmake-rules {
+          inherit (buildConfig) moduleOverrides;
+        };
+        
+        # The same tree built with features.buildTrace, for build-time profiling
+        tracedModules = cmake-rules.resolveModuleDependenciesWithConfig moduleDiscovery pkgs cmake-rules {
+          inherit (buildConfig) moduleOverrides;
+          defaultBuildConfig.features.buildTrace = true;
+        };
+        
+        # Benchmark check of every module with benchmarks; without a baseline
+        # it only records a candidate in result/benchmark-baseline.json
+        benchmarkChecks = builtins.listToAttrs (map (name: {
+          name = "${name}-benchmarks";
+          value = cmake-rules.mkBenchmarkCheck { module = modules.${name}; };
+        }) (builtins.filter (name: (modules.${name}.passthru.moduleBenchmarks or []) != [])
+              (builtins.attrNames modules)));
+        
+        # Widest set of modules that can build at the same time
+        widestLevel = pkgs.lib.foldl' pkgs.lib.max 1 (map builtins.length (cmake-rules.dependencyLevels modules));
+        
       in {
         # Export the rules for other flakes to use
         lib = cmake-rules;
@@ -42,13 +62,17 @@
         };
 
         # Individual module packages
-        packages = modules // {
+        packages = modules // benchmarkChecks // {
           # Default: build all modules
           default = pkgs.symlinkJoin {
             name = "cmake-nix-rules-examples";
             paths = builtins.attrValues modules;
           };
           
+          # Build-time profile of every module: `nix build .#build-trace`, then
+          # open result/share/build-trace/trace.json in ui.perfetto.dev
+          build-trace = cmake-rules.aggregateBuildTraces tracedModules;
+          
           # Test runner - only evaluate when explicitly built
           tests = pkgs.writeShellScriptBin "run-tests" ''
             echo "Running cmake-nix-rules tests..."
@@ -63,6 +87,12 @@
           '';
         };
 
+        # Benchmark regression gates: `nix build .#checks.<system>.<module>-benchmarks`
+        # fails when a metric regresses past the threshold against the module's
+        # benchmark-baseline.json. Only modules with a committed baseline are
+        # gated; record one with `nix build .#<module>-benchmarks`
+        checks = pkgs.lib.filterAttrs (_: check: check.passthru.baseline != null) benchmarkChecks;
+        
         # Apps for development workflow
         apps = {
           # Test all modules
@@ -87,6 +117,46 @@
             ''}";
           };
           
+          # Build every module, letting Nix run independent modules side by
+          # side: --max-jobs is the widest dependency level (or $BUILD_MAX_JOBS),
+          # capped at the core count, and the cores are divided between jobs
+          # so each module's compile pool gets its share ($NIX_BUILD_CORES)
+          build-all = {
+            type = "app";
+            program = "${pkgs.writeShellScript "build-all" ''
+              set -e
+              cores=$(nproc)
+              jobs="''${BUILD_MAX_JOBS:-${toString widestLevel}}"
+              [ "$jobs" -le "$cores" ] || jobs=$cores
+              echo "Building ${toString (builtins.length (builtins.attrNames modules))} modules with $jobs jobs of $(( cores / jobs )) cores"
+              ${pkgs.nix}/bin/nix build --no-link --max-jobs "$jobs" --cores "$(( cores / jobs ))" \
+                ${builtins.concatStringsSep " " (map (name: "'${modules.${name}.drvPath}^*'") (builtins.attrNames modules))} "$@"
+            ''}";
+          };
+          
+          # Run every module's benchmarks, writing Google Benchmark JSON to
+          # $BENCH_OUT/<module>/<benchmark>.json (default: ./bench-results).
+          # Extra arguments are passed to each benchmark binary.
+          bench-all = {
+            type = "app";
+            program = "${pkgs.writeShellScript "bench-all" ''
+              set -e
+              out="''${BENCH_OUT:-bench-results}"
+              
+              ${builtins.concatStringsSep "\n" (map (name: ''
+                for bench in ${builtins.concatStringsSep " " (modules.${name}.passthru.moduleBenchmarks or [])}; do
+                  mkdir -p "$out/${name}"
+                  echo "Benchmarking ${name}/$bench..."
+                  "${modules.${name}}/bin/$bench" \
+                    --benchmark_out="$out/${name}/$bench.json" \
+                    --benchmark_out_format=json "$@"
+                done
+              '') (builtins.attrNames modules))}
+              
+              echo "Benchmark results written to $out"
+            ''}";
+          };
+          
           # Run math-utils calculator demo
           calculator = {
             type = "app";
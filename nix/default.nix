@@ -7,8 +7,8 @@
   
   # Convenience: expose v1 as default for backward compatibility
   inherit (import ./v1 { inherit pkgs; })
-    mkModule mkLibrary mkExecutable
-    discoverModules aggregateCompileCommands topologicalSort resolveModuleDependencies
+    mkModule mkLibrary mkExecutable mkBenchmarkCheck
+    discoverModules discoverBenchmarkTargets aggregateCompileCommands topologicalSort resolveModuleDependencies resolveModuleDependenciesWithConfig dependencyLevels aggregateBuildTraces
     generateRootCMakeLists generateModuleCMakeLists
     defaultBuildConfig;
   
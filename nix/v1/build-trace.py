@@ -0,0 +1,226 @@
+"""Turn a module build into a Chrome trace and a compile-time summary.
+
+Used by mkModule when features.buildTrace is enabled, and by
+aggregateBuildTraces for the whole monorepo.
+
+  module     Reads .ninja_log (one event per build edge) plus the per-TU
+             reports the compiler left next to each object file:
+             clang -ftime-trace JSON (<object stem>.json) or GCC
+             -ftime-report text (<object>.time-report). Writes trace.json
+             (load in chrome://tracing or ui.perfetto.dev), summary.json
+             and summary.txt.
+  aggregate  Combines module summaries in dependency order. Each module
+             starts once all of its dependencies finished, which gives the
+             critical path of a build with unlimited parallelism.
+"""
+
+import argparse
+import glob
+import json
+import os
+import re
+import sys
+
+TOP = 20
+
+GCC_LINE = re.compile(r"^\s*(.+?)\s*:\s*([\d.]+)\s*\(\s*\d+%\)\s*([\d.]+)\s*\(\s*\d+%\)\s*([\d.]+)")
+GCC_TOTAL = re.compile(r"^\s*TOTAL\s*:\s*([\d.]+)\s+([\d.]+)\s+([\d.]+)")
+
+
+def read_ninja_log(path):
+    """Build edges as (start_ms, end_ms, output); later runs of an edge win."""
+    edges = {}
+    with open(path) as f:
+        header = f.readline()
+        if not header.startswith("# ninja log"):
+            raise ValueError(f"{path}: not a ninja log")
+        for line in f:
+            fields = line.rstrip("\n").split("\t")
+            if len(fields) < 5:
+                continue
+            start, end, _, output, cmdhash = fields[:5]
+            edges[output] = (int(start), int(end), output, cmdhash)
+
+    # Edges with several outputs are logged once per output
+    unique = {}
+    for start, end, output, cmdhash in edges.values():
+        unique.setdefault((start, end, cmdhash), (start, end, output))
+    return sorted(unique.values())
+
+
+def chrome_events(edges, pid, name, offset_ms=0):
+    """One complete event per edge, packed into lanes like Ninja's workers."""
+    events = [{"name": "process_name", "ph": "M", "pid": pid, "args": {"name": name}}]
+    lanes = []
+    for start, end, output in edges:
+        for lane, busy_until in enumerate(lanes):
+            if busy_until <= start:
+                lanes[lane] = end
+                break
+        else:
+            lanes.append(end)
+            lane = len(lanes) - 1
+        events.append({
+            "name": os.path.basename(output),
+            "cat": "compile" if output.endswith(".o") else "link",
+            "ph": "X",
+            "pid": pid,
+            "tid": lane,
+            "ts": (offset_ms + start) * 1000,
+            "dur": (end - start) * 1000,
+            "args": {"output": output},
+        })
+    return events
+
+
+def clang_headers(build_dir):
+    """Inclusive parse time per header, summed over every TU (-ftime-trace)."""
+    headers = {}
+    for path in glob.glob(os.path.join(build_dir, "**", "*.json"), recursive=True):
+        if os.path.basename(path) == "compile_commands.json":
+            continue
+        try:
+            with open(path) as f:
+                trace = json.load(f)
+        except (OSError, ValueError):
+            continue
+        if not isinstance(trace, dict) or "traceEvents" not in trace:
+            continue
+        for event in trace["traceEvents"]:
+            if event.get("name") == "Source" and "dur" in event:
+                header = event.get("args", {}).get("detail", "?")
+                total, count = headers.get(header, (0.0, 0))
+                headers[header] = (total + event["dur"] / 1000.0, count + 1)
+    return headers
+
+
+def gcc_phases(build_dir):
+    """Wall time per -ftime-report phase, summed over every TU."""
+    phases = {}
+    for path in glob.glob(os.path.join(build_dir, "**", "*.time-report"), recursive=True):
+        with open(path, errors="replace") as f:
+            for line in f:
+                match = GCC_TOTAL.match(line)
+                if match:
+                    phases["TOTAL"] = phases.get("TOTAL", 0.0) + float(match.group(3)) * 1000
+                    continue
+                match = GCC_LINE.match(line)
+                if match:
+                    phase = match.group(1)
+                    phases[phase] = phases.get(phase, 0.0) + float(match.group(4)) * 1000
+    return phases
+
+
+def module_command(args):
+    edges = read_ninja_log(os.path.join(args.build_dir, ".ninja_log"))
+    os.makedirs(args.out, exist_ok=True)
+
+    with open(os.path.join(args.out, "trace.json"), "w") as f:
+        json.dump({"traceEvents": chrome_events(edges, 1, args.module)}, f)
+
+    wall_ms = (max(end for _, end, _ in edges) - min(start for start, _, _ in edges)) if edges else 0
+    units = sorted(
+        ({"output": output, "ms": end - start} for start, end, output in edges if output.endswith(".o")),
+        key=lambda unit: unit["ms"], reverse=True)
+    links = sorted(
+        ({"output": output, "ms": end - start} for start, end, output in edges if not output.endswith(".o")),
+        key=lambda unit: unit["ms"], reverse=True)
+    headers = sorted(
+        ({"header": header, "ms": round(ms, 1), "includes": count}
+         for header, (ms, count) in clang_headers(args.build_dir).items()),
+        key=lambda header: header["ms"], reverse=True)
+    phases = sorted(
+        ({"phase": phase, "ms": round(ms, 1)} for phase, ms in gcc_phases(args.build_dir).items()),
+        key=lambda phase: phase["ms"], reverse=True)
+
+    summary = {
+        "module": args.module,
+        "wall_ms": wall_ms,
+        "cpu_ms": sum(end - start for start, end, _ in edges),
+        "translation_units": units,
+        "links": links,
+        "headers": headers[:TOP * 5],
+        "gcc_phases": phases,
+    }
+    with open(os.path.join(args.out, "summary.json"), "w") as f:
+        json.dump(summary, f, indent=2)
+
+    lines = [f"Module {args.module}: {wall_ms / 1000:.2f}s wall, {summary['cpu_ms'] / 1000:.2f}s across jobs", ""]
+    lines.append("Slowest translation units:")
+    lines += [f"  {unit['ms'] / 1000:8.2f}s  {unit['output']}" for unit in units[:TOP]]
+    if links:
+        lines += ["", "Links:"]
+        lines += [f"  {link['ms'] / 1000:8.2f}s  {link['output']}" for link in links[:TOP]]
+    if headers:
+        lines += ["", "Slowest headers (inclusive parse time over all TUs, clang):"]
+        lines += [f"  {h['ms'] / 1000:8.2f}s  {h['includes']:4}x  {h['header']}" for h in headers[:TOP]]
+    if phases:
+        lines += ["", "Compiler phases over all TUs (gcc -ftime-report, wall):"]
+        lines += [f"  {p['ms'] / 1000:8.2f}s  {p['phase']}" for p in phases[:TOP]]
+    with open(os.path.join(args.out, "summary.txt"), "w") as f:
+        f.write("\n".join(lines) + "\n")
+    print("\n".join(lines))
+    return 0
+
+
+def aggregate_command(args):
+    with open(args.modules) as f:
+        modules = json.load(f)  # [{name, dependencies, trace}] in topological order
+
+    finish = {}
+    critical = {}
+    events = []
+    report = []
+    for pid, module in enumerate(modules, start=1):
+        trace_dir = os.path.join(module["trace"], "share", "build-trace")
+        with open(os.path.join(trace_dir, "summary.json")) as f:
+            summary = json.load(f)
+        deps = [dep for dep in module["dependencies"] if dep in finish]
+        start = max((finish[dep] for dep in deps), default=0)
+        finish[module["name"]] = start + summary["wall_ms"]
+        slowest_dep = max(deps, key=lambda dep: finish[dep], default=None)
+        critical[module["name"]] = (critical[slowest_dep] if slowest_dep else []) + [module["name"]]
+
+        with open(os.path.join(trace_dir, "trace.json")) as f:
+            module_events = json.load(f)["traceEvents"]
+        first = min((event["ts"] for event in module_events if event.get("ph") == "X"), default=0)
+        for event in module_events:
+            event["pid"] = pid
+            if event.get("ph") == "X":
+                event["ts"] = event["ts"] - first + start * 1000
+        events += module_events
+        report.append(f"  {start / 1000:8.2f}s -> {finish[module['name']] / 1000:8.2f}s  {module['name']}")
+
+    os.makedirs(args.out, exist_ok=True)
+    with open(os.path.join(args.out, "trace.json"), "w") as f:
+        json.dump({"traceEvents": events}, f)
+
+    last = max(finish, key=finish.get) if finish else None
+    lines = ["Module schedule (each module starts when its dependencies finish):"] + report
+    if last:
+        lines += ["", f"Critical path ({finish[last] / 1000:.2f}s): {' -> '.join(critical[last])}"]
+    with open(os.path.join(args.out, "summary.txt"), "w") as f:
+        f.write("\n".join(lines) + "\n")
+    print("\n".join(lines))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    module = commands.add_parser("module", help="summarize one module build")
+    module.add_argument("--module", required=True, help="module name")
+    module.add_argument("--build-dir", required=True, help="CMake/Ninja build directory")
+    module.add_argument("--out", required=True, help="output directory")
+
+    aggregate = commands.add_parser("aggregate", help="combine module traces")
+    aggregate.add_argument("--modules", required=True, help="JSON list of {name, dependencies, trace}")
+    aggregate.add_argument("--out", required=True, help="output directory")
+
+    args = parser.parse_args()
+    return module_command(args) if args.command == "module" else aggregate_command(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
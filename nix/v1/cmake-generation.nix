@@ -4,6 +4,13 @@
 let
   inherit (pkgs) lib;
   
+  # features.lto: false | true | "fat" | "thin"; null when disabled
+  ltoModeOf = buildConfig:
+    let lto = buildConfig.features.lto or false; in
+    if lto == false then null
+    else if lto == true then "fat"
+    else lto;
+  
   # Generate CMakeLists.txt for a module
   generateModuleCMakeLists = { name, targets, dependencies ? [], externalDeps ? [], fetchContentDeps ? [], buildConfig, src }:
     let
@@ -12,9 +19,149 @@ let
         "-fsanitize=${lib.concatStringsSep "," buildConfig.features.sanitizers}"
       ];
       
-      ltoFlag = lib.optional buildConfig.features.lto "-flto";
+      # Link-time optimization across module boundaries: archives carry
+      # compiler IR (archived with gcc-ar / llvm-ar so the symbol index sees
+      # it) and executables optimize over every LTO module they link.
+      #   "fat":  IR plus machine code; modules without LTO can still link it
+      #   "thin": IR only (ThinLTO with clang); every consumer needs LTO
+      # `true` means "fat".
+      isClang = buildConfig.compiler == "clang";
+      ltoMode = ltoModeOf buildConfig;
+      ltoFlags =
+        if ltoMode == null then []
+        else if ltoMode == "fat" then
+          if isClang then [ "-flto=full" "-ffat-lto-objects" ]
+          else [ "-flto=auto" "-ffat-lto-objects" ]
+        else if ltoMode == "thin" then
+          if isClang then [ "-flto=thin" ]
+          else [ "-flto=auto" "-fno-fat-lto-objects" ]
+        else throw "Unknown LTO mode: ${ltoMode}";
+      ltoArchiver =
+        if isClang then { ar = "${pkgs.llvmPackages.llvm}/bin/llvm-ar"; ranlib = "${pkgs.llvmPackages.llvm}/bin/llvm-ranlib"; }
+        else { ar = "${pkgs.gcc.cc}/bin/gcc-ar"; ranlib = "${pkgs.gcc.cc}/bin/gcc-ranlib"; };
+      
+      # IR-only archives cannot be linked without LTO, or by another compiler
+      checkLtoDependencies = map (dep:
+        let
+          depConfig = dep.passthru.moduleBuildConfig or {};
+          depName = dep.passthru.moduleName or dep.pname;
+        in
+          if ltoModeOf depConfig == "thin" && ltoMode == null then
+            throw "Module '${name}' links thin-LTO module '${depName}'; enable features.lto or use lto = \"fat\" in '${depName}'"
+          else if ltoModeOf depConfig == "thin" && (depConfig.compiler or "gcc") != buildConfig.compiler then
+            throw "Module '${name}' (${buildConfig.compiler}) links thin-LTO module '${depName}' built with ${depConfig.compiler or "gcc"}"
+          else true
+      ) dependencies;
+      
+      # Profile-guided optimization phase, set by mkModule for its PGO variants
+      pgo = buildConfig.features.pgo or {};
+      pgoPhase = pgo.phase or null;
+      pgoFlags =
+        if pgoPhase == "generate" then
+          if buildConfig.compiler == "clang"
+          then [ "-fprofile-instr-generate" ]
+          else [ "-fprofile-generate" "-fprofile-update=atomic" ]
+        else if pgoPhase == "use" then
+          if buildConfig.compiler == "clang"
+          then [ "-fprofile-instr-use=${pgo.profile}/default.profdata" "-Wno-profile-instr-unprofiled" "-Wno-profile-instr-out-of-date" ]
+          else [ "-fprofile-use" "-fprofile-partial-training" "-Wno-missing-profile" ]
+        else if pgoPhase == null then []
+        else throw "Unknown PGO phase: ${pgoPhase}";
+      
+      # Per-TU compile reports for features.buildTrace: clang writes
+      # <object stem>.json, GCC's report is captured by mkModule's launcher
+      traceFlags = lib.optional (buildConfig.features.buildTrace or false)
+        (if isClang then "-ftime-trace" else "-ftime-report");
+      
+      compilerFlags = sanitizerFlags ++ ltoFlags ++ pgoFlags ++ traceFlags;
       
-      compilerFlags = sanitizerFlags ++ ltoFlag;
+      # Executables that link Google Benchmark
+      benchmarkTargets = lib.filterAttrs (targetName: target:
+        target.targetType == "executable" && (target.benchmark or false)
+      ) targets;
+      
+      compileDefinitions = lib.mapAttrsToList (name: value: "${name}=${toString value}") (buildConfig.defines or {});
+      
+      # Target-scoped optimization profile (buildConfig.optimization)
+      optimization = buildConfig.optimization or {};
+      optimizationFlags = march:
+        lib.optional ((optimization.level or null) != null) "-O${toString optimization.level}"
+        ++ lib.optional (march != null) "-march=${march}"
+        ++ lib.optional ((optimization.mtune or null) != null) "-mtune=${optimization.mtune}"
+        ++ lib.optional (optimization.fastMath or false) "-ffast-math"
+        ++ lib.optional (optimization.noPlt or false) "-fno-plt";
+      optimizationDefines = lib.mapAttrsToList (name: value: "${name}=${toString value}") (optimization.defines or {});
+      
+      # Header-only libraries have no sources of their own: every usage
+      # requirement is INTERFACE, and linking needs the INTERFACE keyword
+      isHeaderOnly = target: target.targetType == "library" && target.type == "headerOnly";
+      linkScope = target: lib.optionalString (isHeaderOnly target) "INTERFACE ";
+      
+      # Defines are PUBLIC on libraries: values such as EIGEN_MAX_ALIGN_BYTES
+      # change type layout and must match in every consumer
+      generateOptimization = target:
+        let
+          flags = optimizationFlags (target.isaVariant or optimization.march or null);
+          scope = if isHeaderOnly target then "INTERFACE"
+                  else if target.targetType == "library" then "PUBLIC"
+                  else "PRIVATE";
+        in ''
+          ${lib.optionalString (flags != [] && !(isHeaderOnly target)) "target_compile_options(${target.name} PRIVATE ${lib.concatStringsSep " " flags})"}
+          ${lib.optionalString (optimizationDefines != []) "target_compile_definitions(${target.name} ${scope} ${lib.concatStringsSep " " optimizationDefines})"}
+        '';
+      
+      # One extra build of each library per ISA in optimization.isaVariants,
+      # compiled with -march=<isa>. Shared variants are laid out as
+      # glibc-hwcaps/<isa>/lib<name>.so so the dynamic loader picks the best
+      # one for the running CPU; static variants become lib<name>-<isa>.a.
+      # Only the loader's own subdirectory names are accepted: any other
+      # directory would be ignored at run time.
+      hwcapsLevels = [ "x86-64-v2" "x86-64-v3" "x86-64-v4" ];
+      isaVariants =
+        let
+          requested = optimization.isaVariants or [];
+          unknown = lib.subtractLists hwcapsLevels requested;
+        in
+          if unknown == [] then requested
+          else throw "Module '${name}': unknown ISA variants ${lib.concatStringsSep ", " unknown}; expected ${lib.concatStringsSep ", " hwcapsLevels}";
+      isaVariantTargets = lib.foldl' (acc: targetName:
+        let target = targets.${targetName}; in
+        acc // builtins.listToAttrs (map (isa: {
+          name = "${targetName}-${isa}";
+          value = target // {
+            name = "${target.name}-${isa}";
+            isaVariant = isa;
+            baseName = target.name;
+          };
+        }) isaVariants)
+      ) {} (lib.attrNames (lib.filterAttrs (targetName: target:
+        target.targetType == "library" && !(isHeaderOnly target)) targets));
+      
+      moduleTargets = builtins.seq isaVariants (targets // isaVariantTargets);
+      
+      usesSharedLibraries =
+        lib.any (target: target.targetType == "library" && target.type == "dynamic") (lib.attrValues targets)
+        || lib.any (dep: (dep.passthru.moduleLibraryType or "static") == "dynamic") dependencies;
+      
+      # Precompiled headers and unity builds. Single-source executables gain
+      # nothing from a PCH of their own, so unless they declare one they reuse
+      # the PCH of the module's static library, which is compiled with the
+      # same flags. Benchmarks link extra packages and keep parsing headers.
+      pchLibrary = lib.findFirst (target:
+        target.targetType == "library" && target.type == "static" && (target.precompileHeaders or []) != []
+      ) null (lib.attrValues targets);
+      
+      generateBuildSpeedups = target:
+        let
+          headers = target.precompileHeaders or [];
+          unity = target.unityBuild or false;
+          reusePch = target.targetType == "executable" && headers == []
+            && !(target.benchmark or false) && pchLibrary != null;
+        in ''
+          ${lib.optionalString (headers != []) "target_precompile_headers(${target.name} PRIVATE ${lib.concatMapStringsSep " " (header: "\"${header}\"") headers})"}
+          ${lib.optionalString reusePch "target_precompile_headers(${target.name} REUSE_FROM ${pchLibrary.name})"}
+          ${lib.optionalString (unity != false) "set_target_properties(${target.name} PROPERTIES UNITY_BUILD ON${lib.optionalString (builtins.isInt unity) " UNITY_BUILD_BATCH_SIZE ${toString unity}"})"}
+        '';
       
       # Generate target definitions
       generateTarget = targetName: target:
@@ -26,7 +173,8 @@ let
           throw "Unknown target type: ${target.targetType}";
       
       generateLibraryTarget = targetName: target:
-        let
+        if isHeaderOnly target then generateHeaderOnlyTarget targetName target
+        else let
           libType = if target.type == "static" then "STATIC" else "SHARED";
           # Discover source files using Nix
           sourceFiles = if builtins.pathExists (src + "/src") then
@@ -71,6 +219,52 @@ let
           if(${target.name}_HEADERS)
             set_target_properties(${target.name} PROPERTIES PUBLIC_HEADER "''${${target.name}_HEADERS}")
           endif()
+          ${generateOptimization target}
+          ${generateBuildSpeedups target}
+          ${generateVisibility target libType}
+          ${lib.optionalString (target ? isaVariant && libType == "SHARED") ''
+            set_target_properties(${target.name} PROPERTIES
+              OUTPUT_NAME ${target.baseName}
+              LIBRARY_OUTPUT_DIRECTORY ''${CMAKE_BINARY_DIR}/glibc-hwcaps/${target.isaVariant}
+            )
+          ''}
+        '';
+      
+      # Header-only library: consumers compile (and can inline) everything
+      generateHeaderOnlyTarget = targetName: target:
+        let
+          depIncludeDirs = lib.concatStringsSep " " (map (dep: "${dep}/include") dependencies);
+        in ''
+          # Header-only library: ${targetName}
+          add_library(${target.name} INTERFACE)
+          target_include_directories(${target.name} INTERFACE inc ${depIncludeDirs})
+          ${generateOptimization target}
+        '';
+      
+      # visibility = "hidden": only symbols marked with the generated
+      # <BASE>_EXPORT macro (#include "<library>/export.hpp") are exported,
+      # which shrinks the dynamic symbol table and lets calls inside the
+      # library bind directly instead of through the PLT. Static builds get
+      # <BASE>_STATIC_DEFINE so the same headers work for both types.
+      exportBaseName = target: lib.toUpper (builtins.replaceStrings [ "-" "." ] [ "_" "_" ] (target.baseName or target.name));
+      generateVisibility = target: libType:
+        let
+          baseName = target.baseName or target.name;
+          exportDir = "\${CMAKE_CURRENT_BINARY_DIR}/include";
+        in lib.optionalString ((target.visibility or "default") == "hidden") ''
+          set_target_properties(${target.name} PROPERTIES
+            CXX_VISIBILITY_PRESET hidden
+            VISIBILITY_INLINES_HIDDEN ON
+          )
+          ${lib.optionalString (!(target ? isaVariant)) ''
+            include(GenerateExportHeader)
+            generate_export_header(${target.name}
+              BASE_NAME ${exportBaseName target}
+              EXPORT_FILE_NAME ${exportDir}/${baseName}/export.hpp
+            )
+          ''}
+          target_include_directories(${target.name} PUBLIC $<BUILD_INTERFACE:${exportDir}>)
+          ${lib.optionalString (libType == "STATIC") "target_compile_definitions(${target.name} PUBLIC ${exportBaseName target}_STATIC_DEFINE)"}
         '';
       
       generateExecutableTarget = targetName: target:
@@ -105,6 +299,8 @@ let
           # Executable: ${targetName}
           add_executable(${target.name} ${mainSource} ${additionalSources})
           target_include_directories(${target.name} PRIVATE inc src ${depIncludeDirs})
+          ${generateOptimization target}
+          ${generateBuildSpeedups target}
         '';
       
       # Generate dependency linking
@@ -116,7 +312,7 @@ let
             ''
               # Link internal module dependencies for ${targetName}
               ${lib.concatStringsSep "\n" (map (dep: 
-                "target_link_libraries(${target.name} ${dep.passthru.moduleName or dep.pname})"
+                "target_link_libraries(${target.name} ${linkScope target}${dep.passthru.moduleName or dep.pname})"
               ) dependencies)}
             ''
           ) targetNames;
@@ -139,19 +335,71 @@ let
         ${lib.optionalString (compilerFlags != []) ''
           set(CMAKE_CXX_FLAGS "''${CMAKE_CXX_FLAGS} ${lib.concatStringsSep " " compilerFlags}")
         ''}
+        ${lib.optionalString (builtins.all (check: check) checkLtoDependencies && ltoMode != null) ''
+          
+          # LTO-aware archiver${lib.optionalString isClang " and linker"}
+          set(CMAKE_AR "${ltoArchiver.ar}")
+          set(CMAKE_RANLIB "${ltoArchiver.ranlib}")
+          ${lib.optionalString isClang ''
+            set(CMAKE_EXE_LINKER_FLAGS "''${CMAKE_EXE_LINKER_FLAGS} -fuse-ld=lld")
+            set(CMAKE_SHARED_LINKER_FLAGS "''${CMAKE_SHARED_LINKER_FLAGS} -fuse-ld=lld")
+          ''}
+        ''}
+        
+        # Separate compile and link job pools (Ninja only); mkModule sizes
+        # them from the build's cores and available memory
+        if(CMAKE_GENERATOR MATCHES "Ninja" AND DEFINED MODULE_COMPILE_JOBS AND DEFINED MODULE_LINK_JOBS)
+          set_property(GLOBAL PROPERTY JOB_POOLS compile=''${MODULE_COMPILE_JOBS} link=''${MODULE_LINK_JOBS})
+          set(CMAKE_JOB_POOL_COMPILE compile)
+          set(CMAKE_JOB_POOL_LINK link)
+        endif()
+        
+        # Compile definitions
+        ${lib.optionalString (compileDefinitions != []) ''
+          add_compile_definitions(${lib.concatStringsSep " " compileDefinitions})
+        ''}
         
         # Export compile commands
         set(CMAKE_EXPORT_COMPILE_COMMANDS ON)
         
+        ${lib.optionalString usesSharedLibraries ''
+          # Binaries are copied out of the build tree, so link with the final
+          # RPATH: this module's lib/ (and its glibc-hwcaps subdirectories)
+          # plus the store paths of shared dependencies
+          set(CMAKE_BUILD_WITH_INSTALL_RPATH ON)
+          set(CMAKE_INSTALL_RPATH "\$ORIGIN/../lib")
+          set(CMAKE_INSTALL_RPATH_USE_LINK_PATH ON)
+        ''}
+        
         # Internal module dependencies (imported targets)
-        ${lib.concatStringsSep "\n" (map (dep: ''
-          # Import ${dep.passthru.moduleName or dep.pname} module
-          add_library(${dep.passthru.moduleName or dep.pname} STATIC IMPORTED)
-          set_target_properties(${dep.passthru.moduleName or dep.pname} PROPERTIES
-            IMPORTED_LOCATION "${dep}/lib/lib${dep.passthru.moduleName or dep.pname}.a"
-            INTERFACE_INCLUDE_DIRECTORIES "${dep}/include"
-          )
-        '') dependencies)}
+        ${lib.concatStringsSep "\n" (map (dep:
+          let
+            depName = dep.passthru.moduleName or dep.pname;
+            libraryName = dep.passthru.moduleLibraryName or depName;
+            libraryType = dep.passthru.moduleLibraryType or "static";
+            # The module's PUBLIC optimization defines (see generateOptimization)
+            depDefines = lib.mapAttrsToList (name: value: "${name}=${toString value}")
+              (dep.passthru.moduleBuildConfig.optimization.defines or {});
+            interfaceDefines = lib.optionalString (depDefines != [])
+              "INTERFACE_COMPILE_DEFINITIONS \"${lib.concatStringsSep ";" depDefines}\"";
+          in
+            if libraryType == "headerOnly" then ''
+              # Import ${depName} module (header-only)
+              add_library(${depName} INTERFACE IMPORTED)
+              set_target_properties(${depName} PROPERTIES
+                INTERFACE_INCLUDE_DIRECTORIES "${dep}/include"
+                ${interfaceDefines}
+              )
+            '' else ''
+              # Import ${depName} module
+              add_library(${depName} ${if libraryType == "dynamic" then "SHARED" else "STATIC"} IMPORTED)
+              set_target_properties(${depName} PROPERTIES
+                IMPORTED_LOCATION "${dep}/lib/lib${libraryName}.${if libraryType == "dynamic" then "so" else "a"}"
+                INTERFACE_INCLUDE_DIRECTORIES "${dep}/include"
+                ${interfaceDefines}
+              )
+            ''
+        ) dependencies)}
         
         # Collect transitive external dependencies from internal dependencies
         ${let
@@ -180,6 +428,9 @@ let
           ) uniqueExternalDeps)
         }
         
+        # Google Benchmark, only needed when the module has benchmarks
+        ${lib.optionalString (benchmarkTargets != {}) "find_package(benchmark REQUIRED)"}
+        
         # FetchContent dependencies (escape hatch)
         ${lib.optionalString (fetchContentDeps != []) ''
           include(FetchContent)
@@ -194,10 +445,10 @@ let
         ''}
         
         # Targets
-        ${lib.concatStringsSep "\n\n" (lib.mapAttrsToList generateTarget targets)}
+        ${lib.concatStringsSep "\n\n" (lib.mapAttrsToList generateTarget moduleTargets)}
         
         # Link dependencies
-        ${generateDependencies targets}
+        ${generateDependencies moduleTargets}
         
         # Link external dependencies (direct + transitive)
         ${let
@@ -224,13 +475,14 @@ let
                               then ["${dep.pkg.pname}::${dep.pkg.pname}"]  # common pattern
                               else ["${dep.pname}::${dep.pname}"];         # simple package
               in lib.concatStringsSep "\n" (map (cmakeTarget: 
-                "target_link_libraries(${target.name} ${cmakeTarget})"
+                "target_link_libraries(${target.name} ${linkScope target}${cmakeTarget})"
               ) cmakeTargets)
             ) uniqueExternalDeps)
-          ) targets)
+          ) moduleTargets)
         }
         
-        # Link executables to libraries within the same module
+        # Link executables to libraries within the same module (ISA variants
+        # are alternatives to their library, never linked alongside it)
         ${let
           libraries = lib.filterAttrs (name: target: target.targetType == "library") targets;
           executables = lib.filterAttrs (name: target: target.targetType == "executable") targets;
@@ -239,17 +491,22 @@ let
           lib.concatStringsSep "\n" (map (libName: "target_link_libraries(${execTarget.name} ${libName})") libraryNames)
         ) executables)}
         
+        # Link benchmark executables to Google Benchmark
+        ${lib.concatStringsSep "\n" (lib.mapAttrsToList (targetName: target:
+          "target_link_libraries(${target.name} benchmark::benchmark)"
+        ) benchmarkTargets)}
+        
         # Install headers for use by other modules
         ${lib.concatStringsSep "\n" (lib.mapAttrsToList (targetName: target:
           if target.targetType == "library" then ''
             install(TARGETS ${target.name}
-              LIBRARY DESTINATION lib
+              LIBRARY DESTINATION ${if target ? isaVariant then "lib/glibc-hwcaps/${target.isaVariant}" else "lib"}
               ARCHIVE DESTINATION lib
               PUBLIC_HEADER DESTINATION include
             )
             install(DIRECTORY inc/ DESTINATION include PATTERN "*")
           '' else ""
-        ) targets)}
+        ) moduleTargets)}
       '';
       
     in pkgs.writeText "CMakeLists.txt" cmakeContent;
@@ -0,0 +1,136 @@
+"""Compare Google Benchmark JSON results against a stored baseline.
+
+Used by mkBenchmarkCheck. Each result file is named after its benchmark
+executable (<exe>.json); benchmarks are keyed as "<exe>/<run name>".
+
+Tracked metrics per benchmark:
+  real_time_ns      ns/op, lower is better
+  items_per_second  throughput, higher is better
+  bytes_per_second  throughput, higher is better
+
+With repetitions the median aggregate is compared, otherwise the single
+iteration run. The check fails when a metric regresses past the threshold,
+when a benchmark reports an error, or when a baseline benchmark is missing
+from the results (e.g. it crashed or was renamed).
+
+The candidate baseline written to --candidate has the same format as the
+baseline file, so it can be committed as-is.
+
+Benchmarks skipped with SkipWithMessage (e.g. for a CPU feature the host
+lacks) are reported but neither compared nor counted as missing.
+"""
+
+import argparse
+import json
+import os
+import sys
+
+TIME_UNITS_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+LOWER_IS_BETTER = {"real_time_ns"}
+THROUGHPUT = ("items_per_second", "bytes_per_second")
+
+
+def collect(result_files):
+    """Metrics per benchmark key, and messages of failed and skipped benchmarks."""
+    metrics = {}
+    errors = {}
+    skipped = {}
+    for path in result_files:
+        exe = os.path.splitext(os.path.basename(path))[0]
+        with open(path) as f:
+            report = json.load(f)
+        for bench in report.get("benchmarks", []):
+            key = f"{exe}/{bench.get('run_name', bench['name'])}"
+            if bench.get("error_occurred"):
+                errors[key] = bench.get("error_message", "unknown error")
+                continue
+            if "error_message" in bench:
+                skipped[key] = bench["error_message"]
+                continue
+            if bench.get("run_type") == "aggregate":
+                if bench.get("aggregate_name") != "median":
+                    continue
+            elif bench.get("run_type", "iteration") != "iteration":
+                continue
+
+            values = {
+                "real_time_ns": bench["real_time"] * TIME_UNITS_NS[bench.get("time_unit", "ns")],
+            }
+            for name in THROUGHPUT:
+                if name in bench:
+                    values[name] = bench[name]
+            metrics[key] = values
+    return metrics, errors, skipped
+
+
+def regression(metric, baseline, current):
+    """Relative slowdown; positive means worse than the baseline."""
+    if baseline <= 0 or current <= 0:
+        return 0.0
+    if metric in LOWER_IS_BETTER:
+        return current / baseline - 1.0
+    return baseline / current - 1.0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--baseline", help="baseline JSON; missing means no comparison")
+    parser.add_argument("--threshold", type=float, required=True,
+                        help="allowed relative regression, e.g. 0.10 for 10%%")
+    parser.add_argument("--candidate", required=True, help="where to write the new baseline")
+    parser.add_argument("results", nargs="*", help="Google Benchmark JSON files")
+    args = parser.parse_args()
+
+    current, errors, skipped = collect(args.results)
+    with open(args.candidate, "w") as f:
+        json.dump({"benchmarks": current}, f, indent=2, sort_keys=True)
+        f.write("\n")
+
+    failures = []
+    for key in sorted(errors):
+        print(f"ERROR    {key}: {errors[key]}")
+        failures.append(f"{key} failed: {errors[key]}")
+    for key in sorted(skipped):
+        print(f"SKIPPED  {key}: {skipped[key]}")
+
+    if not args.baseline or not os.path.exists(args.baseline):
+        print(f"No baseline found; {len(current)} benchmarks recorded, nothing compared.")
+        print(f"Commit {args.candidate} as benchmark-baseline.json to start tracking.")
+        return report(failures, None)
+
+    with open(args.baseline) as f:
+        baseline = json.load(f).get("benchmarks", {})
+    threshold = args.threshold
+
+    for key in sorted(current):
+        if key not in baseline:
+            print(f"NEW      {key}")
+            continue
+        for metric, value in sorted(current[key].items()):
+            if metric not in baseline[key]:
+                continue
+            change = regression(metric, baseline[key][metric], value)
+            status = "REGRESS" if change > threshold else "ok"
+            print(f"{status:8} {key} {metric}: {baseline[key][metric]:.6g} -> {value:.6g} ({change:+.1%})")
+            if change > threshold:
+                failures.append(f"{key} {metric} regressed {change:.1%}")
+    for key in sorted(set(baseline) - set(current) - set(errors) - set(skipped)):
+        print(f"MISSING  {key}")
+        failures.append(f"{key} is in the baseline but produced no result")
+
+    return report(failures, threshold)
+
+
+def report(failures, threshold):
+    if failures:
+        print(f"\n{len(failures)} failure(s):")
+        for failure in failures:
+            print(f"  {failure}")
+        return 1
+    if threshold is not None:
+        print(f"\nNo regressions past {threshold:.0%}.")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -6,6 +6,7 @@ let
   mkModule = import ./mkModule.nix { inherit pkgs; };
   mkLibrary = import ./mkLibrary.nix { inherit pkgs; };
   mkExecutable = import ./mkExecutable.nix { inherit pkgs; };
+  mkBenchmarkCheck = import ./mkBenchmarkCheck.nix { inherit pkgs; };
   cmakeGen = import ./cmake-generation.nix { inherit pkgs; };
   utils = import ./utils.nix { inherit pkgs; };
 
@@ -13,9 +14,13 @@ in rec {
   # Main API functions
   inherit mkModule mkLibrary mkExecutable;
   
+  # Benchmark regression gate for a built module
+  inherit mkBenchmarkCheck;
+  
   # Utility functions - discoverModules needs access to the main functions
   discoverModules = utils.discoverModules { inherit mkModule mkLibrary mkExecutable; };
-  inherit (utils) aggregateCompileCommands topologicalSort resolveModuleDependencies;
+  discoverBenchmarkTargets = utils.discoverBenchmarkTargets mkExecutable;
+  inherit (utils) aggregateCompileCommands topologicalSort resolveModuleDependencies resolveModuleDependenciesWithConfig dependencyLevels aggregateBuildTraces;
   
   # CMake generation utilities
   inherit (cmakeGen) generateRootCMakeLists generateModuleCMakeLists;
@@ -27,11 +32,34 @@ in rec {
     cppStandard = "20";
     generator = "ninja";           # Default to Ninja for performance
     buildSystem = "cmake";         # v1 is CMake-only
+    defines = {};                  # Preprocessor definitions for every target
+    optimization = {
+      level = null;                # -O<level> on each target, e.g. "3"
+      march = null;                # -march=, e.g. "x86-64-v3" or "native"
+      mtune = null;                # -mtune=
+      fastMath = false;            # -ffast-math
+      noPlt = false;               # -fno-plt
+      defines = {};                # PUBLIC on libraries so consumers agree on ABI
+      isaVariants = [];            # Extra library builds per glibc-hwcaps level
+    };
     features = {
       sanitizers = [];
-      lto = false;
+      lto = false;                 # false | true | "fat" | "thin"; true = "fat"
       static = false;
-      parallelJobs = "auto";       # Auto-detect CPU cores
+      parallelJobs = "auto";       # Compile jobs; "auto" = the cores Nix assigns ($NIX_BUILD_CORES)
+      linkJobs = "auto";           # Link jobs; "auto" = bounded by free memory (1 GiB, 4 GiB with LTO)
+      compilerCache = {
+        enable = false;            # Compile through ccache/sccache
+        tool = "ccache";           # "ccache" | "sccache"
+        dir = "/var/cache/ccache"; # Shared cache; add to nix.conf extra-sandbox-paths
+      };
+      splitTargets = false;        # Library and each executable in separate derivations
+      buildTrace = false;          # Per-TU compile times and a Chrome trace in the `trace` output
+      pgo = {
+        enable = false;            # Instrument, train, then rebuild with the profile
+        trainingTarget = null;     # Executable target run to collect the profile
+        trainingArgs = [];         # Arguments for the training run
+      };
     };
   };
 }
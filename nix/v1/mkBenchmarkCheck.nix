@@ -0,0 +1,64 @@
+# mkBenchmarkCheck: check derivation that runs a module's benchmarks and
+# fails when a tracked metric regresses past `threshold` against the
+# baseline committed next to the module's default.nix, or when a benchmark
+# errors or disappears
+{ pkgs }:
+
+{ module                      # Module derivation from mkModule
+, baseline ? null             # Baseline JSON (default: <module src>/benchmark-baseline.json)
+, threshold ? 0.10            # Allowed relative regression per metric (0.10 = 10%)
+, benchmarkArgs ? [           # Extra arguments for every benchmark executable
+    "--benchmark_repetitions=5"
+    "--benchmark_report_aggregates_only=true"
+  ]
+}:
+
+let
+  inherit (pkgs) lib;
+  
+  moduleName = module.passthru.moduleName;
+  benchmarks = module.passthru.moduleBenchmarks or [];
+  
+  defaultBaseline =
+    let src = module.passthru.moduleSrc or null;
+    in if src != null && builtins.pathExists (src + "/benchmark-baseline.json")
+       then src + "/benchmark-baseline.json"
+       else null;
+  
+  baselineFile = if baseline != null then baseline else defaultBaseline;
+
+in pkgs.runCommand "${moduleName}-benchmark-check" {
+  nativeBuildInputs = [ pkgs.python3 ];
+  
+  # Compare timings from the machine the baseline was recorded on
+  preferLocalBuild = true;
+  
+  passthru = {
+    inherit moduleName benchmarks threshold;
+    baseline = baselineFile;
+  };
+} ''
+  set -o pipefail
+  mkdir -p $out/results
+  
+  # Benchmarks may write scratch files into the working directory
+  cd "$TMPDIR"
+  
+  ${lib.concatStringsSep "\n" (map (bench: ''
+    echo "Running ${bench}..."
+    ${module}/bin/${bench} \
+      --benchmark_out=$out/results/${bench}.json \
+      --benchmark_out_format=json \
+      ${lib.escapeShellArgs benchmarkArgs}
+  '') benchmarks)}
+  
+  # The candidate baseline is always written, so a missing baseline passes
+  # (unless a benchmark reports an error) and leaves
+  # $out/benchmark-baseline.json ready to commit
+  python3 ${./compare-benchmarks.py} \
+    ${lib.optionalString (baselineFile != null) "--baseline ${baselineFile}"} \
+    --threshold ${toString threshold} \
+    --candidate $out/benchmark-baseline.json \
+    ${lib.concatStringsSep " " (map (bench: "$out/results/${bench}.json") benchmarks)} \
+    | tee $out/report.txt
+''
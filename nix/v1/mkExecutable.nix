@@ -4,10 +4,13 @@
 { name
 , entrypoint
 , sources ? []
+, benchmark ? false  # Link Google Benchmark (set for targets discovered in benchmarks/)
+, precompileHeaders ? []  # Own precompiled headers; default reuses the module library's
+, unityBuild ? false      # false | true | batch size
 }:
 
 {
-  inherit name entrypoint sources;
+  inherit name entrypoint sources benchmark precompileHeaders unityBuild;
   targetType = "executable";
   
   # Validate entrypoint exists (we'll validate at build time)
@@ -2,16 +2,24 @@
 { pkgs }:
 
 { name
-, type ? "static"  # "static" | "dynamic"
+, type ? "static"  # "static" | "dynamic" | "headerOnly"
+, visibility ? "default"  # "default" | "hidden": export only symbols marked <NAME>_EXPORT
+, precompileHeaders ? []  # Heavy headers to precompile, e.g. [ "<Eigen/Dense>" ]
+, unityBuild ? false      # false | true | batch size: compile sources in merged batches
 }:
 
 {
-  inherit name type;
+  inherit name type visibility precompileHeaders unityBuild;
   targetType = "library";
   
   # Validate library type
   __checkType = 
-    if (type != "static" && type != "dynamic") 
-    then throw "Library type must be 'static' or 'dynamic', got: ${type}"
+    if (type != "static" && type != "dynamic" && type != "headerOnly") 
+    then throw "Library type must be 'static', 'dynamic' or 'headerOnly', got: ${type}"
+    else true;
+  
+  __checkVisibility =
+    if (visibility != "default" && visibility != "hidden")
+    then throw "Library visibility must be 'default' or 'hidden', got: ${visibility}"
     else true;
 }
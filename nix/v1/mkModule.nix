@@ -14,6 +14,7 @@
 let
   utils = import ./utils.nix { inherit pkgs; };
   cmakeGen = import ./cmake-generation.nix { inherit pkgs; };
+  mkExecutable = import ./mkExecutable.nix { inherit pkgs; };
   
   # Merge with default build config (v1)
   defaultConfig = {
@@ -22,11 +23,34 @@ let
     cppStandard = "20";
     generator = "ninja";
     buildSystem = "cmake";
+    defines = {};
+    optimization = {
+      level = null;        # -O<level>, e.g. "2", "3", "s"
+      march = null;
+      mtune = null;
+      fastMath = false;
+      noPlt = false;
+      defines = {};        # PUBLIC on libraries, PRIVATE on executables
+      isaVariants = [];    # Extra library builds: "x86-64-v2", "x86-64-v3" or "x86-64-v4"
+    };
     features = {
       sanitizers = [];
       lto = false;
       static = false;
       parallelJobs = "auto";
+      linkJobs = "auto";
+      compilerCache = {
+        enable = false;
+        tool = "ccache";             # "ccache" | "sccache"
+        dir = "/var/cache/ccache";   # Must be in the sandbox (extra-sandbox-paths)
+      };
+      splitTargets = false;
+      buildTrace = false;
+      pgo = {
+        enable = false;
+        trainingTarget = null;
+        trainingArgs = [];
+      };
     };
   };
   
@@ -38,115 +62,357 @@ let
     then throw "Module '${name}' must have at least one target"
     else true;
     
-  # Generate CMakeLists.txt for this module
-  moduleCMakeLists = cmakeGen.generateModuleCMakeLists {
-    inherit name targets externalDeps fetchContentDeps src;
-    dependencies = internalDeps;  # Pass resolved internal dependencies
-    buildConfig = finalBuildConfig;
-  };
-
-in pkgs.stdenv.mkDerivation {
-  pname = "${name}-module";
-  version = "0.1.0";
-  
-  src = if src != null then src else ./.;
-  
-  nativeBuildInputs = with pkgs; [
-    cmake
-    pkg-config
-  ] ++ (if finalBuildConfig.generator == "ninja" then [ ninja ] else [])
-    ++ (if finalBuildConfig.compiler == "clang" then [ clang ] else [ gcc ]);
-  
-  buildInputs = let
-    # Extract external packages from direct external dependencies
-    directExternalPkgs = map (dep: 
-      if builtins.isAttrs dep && dep ? pkg 
-      then dep.pkg 
-      else dep
-    ) externalDeps;
-    
-    # Extract transitive external packages from internal dependencies
-    transitiveExternalPkgs = pkgs.lib.flatten (map (internalDep: 
-      if internalDep ? passthru && internalDep.passthru ? moduleExternalDeps then
-        map (dep: 
-          if builtins.isAttrs dep && dep ? pkg 
-          then dep.pkg 
-          else dep
-        ) internalDep.passthru.moduleExternalDeps
-      else []
-    ) internalDeps);
-    
-    # Combine all external packages and add internal dependencies
-    allExternalPkgs = directExternalPkgs ++ transitiveExternalPkgs;
-  in
-    allExternalPkgs ++ internalDeps;
-  
-  # Validation
-  __validate = validateTargets targets;
-  
-  configurePhase = ''
-    runHook preConfigure
-    
-    # Create build directory
-    mkdir -p build
-    cd build
-    
-    # Write the generated CMakeLists.txt
-    cp ${moduleCMakeLists} ../CMakeLists.txt
-    
-    # Configure with CMake
-    cmake .. \
-      -G ${if finalBuildConfig.generator == "ninja" then "Ninja" else "Unix Makefiles"} \
-      -DCMAKE_BUILD_TYPE=${finalBuildConfig.buildType} \
-      -DCMAKE_CXX_STANDARD=${finalBuildConfig.cppStandard} \
-      -DCMAKE_EXPORT_COMPILE_COMMANDS=ON
-    
-    runHook postConfigure
+  # Benchmarks auto-discovered from benchmarks/; declared targets take precedence
+  benchmarkTargets = utils.discoverBenchmarkTargets mkExecutable src targets;
+  allTargets = benchmarkTargets // targets;
+  benchmarkNames = map (target: target.name)
+    (builtins.filter (target: target.benchmark or false) (builtins.attrValues allTargets));
+  
+  # Generate CMakeLists.txt for this module; `pgo` selects the PGO phase
+  # ({ phase = "generate"; } or { phase = "use"; profile = <drv>; }), split
+  # builds pass a subset of the targets and the source tree they build from
+  moduleCMakeLists = { pgo ? {}, cmakeTargets ? allTargets, cmakeSrc ? src, cmakeDeps ? internalDeps }:
+    cmakeGen.generateModuleCMakeLists {
+      inherit name externalDeps fetchContentDeps;
+      src = cmakeSrc;
+      targets = cmakeTargets;
+      dependencies = cmakeDeps;  # Pass resolved internal dependencies
+      buildConfig = pkgs.lib.recursiveUpdate finalBuildConfig { features.pgo = pgo; };
+    };
+  
+  # Compiler cache shared across builds. The directory has to be visible in
+  # the sandbox (nix.conf: extra-sandbox-paths) and writable by the build
+  # users; when it is not, the build goes ahead uncached
+  compilerCache = finalBuildConfig.features.compilerCache;
+  compilerCachePackage = {
+    ccache = pkgs.ccache;
+    sccache = pkgs.sccache;
+  }.${compilerCache.tool} or (throw "Unknown compiler cache: ${compilerCache.tool}");
+  
+  # Build tracing: per-TU compiler reports plus the Ninja log, summarized
+  # into a separate `trace` output. Trace builds skip the compiler cache so
+  # every timing comes from a real compile
+  buildTrace = finalBuildConfig.features.buildTrace;
+  useCompilerCache = compilerCache.enable && !buildTrace;
+  
+  # GCC prints -ftime-report on stderr; keep it next to the object file and
+  # pass the compiler's own diagnostics through
+  timeReportLauncher = pkgs.writeShellScript "time-report-launcher" ''
+    output=""
+    previous=""
+    for arg in "$@"; do
+      [ "$previous" = "-o" ] && output=$arg
+      previous=$arg
+    done
+    [ -n "$output" ] || exec "$@"
+    "$@" 2> "$output.time-report" && status=0 || status=$?
+    sed '/^Time variable/,$d' "$output.time-report" >&2
+    exit $status
   '';
   
-  buildPhase = ''
-    runHook preBuild
+  checkBuildTrace =
+    if buildTrace && finalBuildConfig.generator != "ninja"
+    then throw "Module '${name}': features.buildTrace reads the Ninja log and requires generator = \"ninja\""
+    else true;
+  
+  # Library that dependent modules link against
+  moduleLibrary = pkgs.lib.findFirst (target: target.targetType == "library")
+    { inherit name; type = "static"; } (builtins.attrValues allTargets);
+  
+  # Plain module build (also the base of the PGO and split variants below)
+  baseModule = pkgs.stdenv.mkDerivation {
+    pname = "${name}-module";
+    version = "0.1.0";
     
-    # Build all targets with parallel jobs
-    ${if finalBuildConfig.features.parallelJobs == "auto" then ''
-      cmake --build . --parallel
-    '' else ''
-      cmake --build . --parallel ${toString finalBuildConfig.features.parallelJobs}
-    ''}
+    outputs = [ "out" ] ++ pkgs.lib.optional buildTrace "trace";
     
-    runHook postBuild
-  '';
+    cmakeLists = moduleCMakeLists {};
+    
+    src = if src != null then src else ./.;
+    
+    nativeBuildInputs = with pkgs; [
+      cmake
+      pkg-config
+    ] ++ (if finalBuildConfig.generator == "ninja" then [ ninja ] else [])
+      ++ (if finalBuildConfig.compiler == "clang" then [ clang ] else [ gcc ])
+      ++ pkgs.lib.optional (finalBuildConfig.compiler == "clang" && finalBuildConfig.features.lto != false) lld
+      ++ pkgs.lib.optional useCompilerCache compilerCachePackage
+      ++ pkgs.lib.optional buildTrace python3;
+    
+    buildInputs = let
+      # Extract external packages from direct external dependencies
+      directExternalPkgs = map (dep: 
+        if builtins.isAttrs dep && dep ? pkg 
+        then dep.pkg 
+        else dep
+      ) externalDeps;
+      
+      # Extract transitive external packages from internal dependencies
+      transitiveExternalPkgs = pkgs.lib.flatten (map (internalDep: 
+        if internalDep ? passthru && internalDep.passthru ? moduleExternalDeps then
+          map (dep: 
+            if builtins.isAttrs dep && dep ? pkg 
+            then dep.pkg 
+            else dep
+          ) internalDep.passthru.moduleExternalDeps
+        else []
+      ) internalDeps);
+      
+      # Combine all external packages and add internal dependencies
+      allExternalPkgs = directExternalPkgs ++ transitiveExternalPkgs;
+    in
+      allExternalPkgs ++ internalDeps
+      ++ pkgs.lib.optional (benchmarkNames != []) pkgs.gbenchmark;
+    
+    # Validation
+    __validate = validateTargets targets && checkBuildTrace;
+    
+    configurePhase = ''
+      runHook preConfigure
+      
+      # Create build directory
+      mkdir -p build
+      cd build
+      
+      # Write the generated CMakeLists.txt
+      cp $cmakeLists ../CMakeLists.txt
+      
+      # Compile jobs: features.parallelJobs, or the cores Nix gives this build
+      # (0 means all of them). Link jobs are also capped by available memory
+      # so parallel links, LTO links above all, cannot run the builder out of RAM
+      compileJobs=${if finalBuildConfig.features.parallelJobs == "auto"
+        then "\${NIX_BUILD_CORES:-0}"
+        else toString finalBuildConfig.features.parallelJobs}
+      [ "$compileJobs" -gt 0 ] || compileJobs=$(nproc)
+      ${if finalBuildConfig.features.linkJobs == "auto" then ''
+        memoryGiB=$(( $(awk '/^MemAvailable:/ { print $2 }' /proc/meminfo) / 1048576 ))
+        linkJobs=$(( memoryGiB / ${if finalBuildConfig.features.lto != false then "4" else "1"} ))
+        [ "$linkJobs" -le "$compileJobs" ] || linkJobs=$compileJobs
+        [ "$linkJobs" -ge 1 ] || linkJobs=1
+      '' else ''
+        linkJobs=${toString finalBuildConfig.features.linkJobs}
+      ''}
+      echo "Building with $compileJobs compile and $linkJobs link jobs"
+      
+      launchers=()
+      ${pkgs.lib.optionalString (buildTrace && finalBuildConfig.compiler != "clang") ''
+        launchers+=(${timeReportLauncher})
+      ''}
+      ${pkgs.lib.optionalString useCompilerCache ''
+        if [ -d "${compilerCache.dir}" ] && [ -w "${compilerCache.dir}" ]; then
+          # Paths relative to the build root keep hits across derivations
+          export CCACHE_DIR="${compilerCache.dir}" CCACHE_BASEDIR="$NIX_BUILD_TOP"
+          export CCACHE_NOHASHDIR=1 CCACHE_COMPRESS=1 CCACHE_UMASK=007
+          export SCCACHE_DIR="${compilerCache.dir}"
+          launchers+=(${compilerCache.tool})
+        else
+          echo "Compiler cache ${compilerCache.dir} is not available in the sandbox; building uncached"
+        fi
+      ''}
+      launcherFlags=()
+      if [ ''${#launchers[@]} -gt 0 ]; then
+        launcherFlags+=("-DCMAKE_CXX_COMPILER_LAUNCHER=$(IFS=';'; echo "''${launchers[*]}")")
+      fi
+      
+      # Configure with CMake
+      cmake .. \
+        -G ${if finalBuildConfig.generator == "ninja" then "Ninja" else "Unix Makefiles"} \
+        -DCMAKE_BUILD_TYPE=${finalBuildConfig.buildType} \
+        -DCMAKE_CXX_STANDARD=${finalBuildConfig.cppStandard} \
+        -DCMAKE_EXPORT_COMPILE_COMMANDS=ON \
+        -DMODULE_COMPILE_JOBS=$compileJobs \
+        -DMODULE_LINK_JOBS=$linkJobs \
+        "''${launcherFlags[@]}"
+      
+      runHook postConfigure
+    '';
+    
+    buildPhase = ''
+      runHook preBuild
+      
+      # Build all targets; with Ninja the job pools above bound each kind
+      cmake --build . --parallel "$compileJobs"
+      
+      runHook postBuild
+    '';
+    
+    installPhase = ''
+      runHook preInstall
+      
+      # Create output structure
+      mkdir -p $out/{bin,lib,include,share}
+      
+      # Install built artifacts (ISA variants keep their glibc-hwcaps layout)
+      find . -path ./glibc-hwcaps -prune -o \( -name "*.a" -o -name "*.so" \) -print | xargs -I {} cp {} $out/lib/ || true
+      find . -perm -111 -type f ! -name "*.so" | xargs -I {} cp {} $out/bin/ || true
+      if [ -d glibc-hwcaps ]; then
+        cp -r glibc-hwcaps $out/lib/
+      fi
+      
+      # Copy headers if they exist, including generated export headers
+      if [ -d ../inc ]; then
+        cp -r ../inc/* $out/include/
+      fi
+      if [ -d include ]; then
+        cp -r include/* $out/include/
+      fi
+      
+      # Copy compile_commands.json
+      if [ -f compile_commands.json ]; then
+        cp compile_commands.json $out/share/
+      fi
+      
+      ${pkgs.lib.optionalString buildTrace ''
+        # Chrome trace and slowest TUs/headers for this module
+        python3 ${./build-trace.py} module --module ${name} --build-dir . --out $trace/share/build-trace
+      ''}
+      
+      runHook postInstall
+    '';
+    
+    # Expose module metadata
+    passthru = {
+      moduleName = name;
+      moduleLibraryName = moduleLibrary.name;
+      moduleLibraryType = moduleLibrary.type;  # "static" | "dynamic" | "headerOnly"
+      moduleTargets = targets;
+      moduleBenchmarks = benchmarkNames;  # Benchmark executables in $out/bin
+      moduleSrc = src;  # Module source directory (benchmark-baseline.json lives here)
+      moduleDependencies = dependencies;  # Original dependency names (strings)
+      resolvedDependencies = internalDeps;  # Actual resolved derivations
+      moduleExternalDeps = externalDeps;  # External dependencies for transitive propagation
+      moduleBuildConfig = finalBuildConfig;
+    };
+  };
+  
+  # Profile-guided optimization: build an instrumented variant, run the
+  # training executable in its own derivation to collect the profile, then
+  # rebuild with the profile applied
+  pgoConfig = finalBuildConfig.features.pgo;
+  isClang = finalBuildConfig.compiler == "clang";
   
-  installPhase = ''
-    runHook preInstall
+  trainingExecutable =
+    let
+      requested = pgoConfig.trainingTarget;
+      target = if requested == null then null
+               else allTargets.${requested} or (pkgs.lib.findFirst
+                 (candidate: candidate.name == requested) null (builtins.attrValues allTargets));
+    in
+      if requested == null then
+        throw "Module '${name}': features.pgo.enable requires features.pgo.trainingTarget"
+      else if target == null || target.targetType != "executable" then
+        throw "Module '${name}': PGO training target '${requested}' is not an executable target"
+      else target.name;
+  
+  instrumentedModule = baseModule.overrideAttrs (old: {
+    pname = "${name}-module-pgo-instrumented";
+    cmakeLists = moduleCMakeLists { pgo = { phase = "generate"; }; };
     
-    # Create output structure
-    mkdir -p $out/{bin,lib,include,share}
+    # GCC records absolute .gcda paths; keep the build directory so the
+    # training run can make them relative to it
+    postInstall = (old.postInstall or "") + ''
+      pwd > $out/share/pgo-build-dir
+    '';
+  });
+  
+  pgoProfile = pkgs.runCommand "${name}-pgo-profile" {
+    nativeBuildInputs = pkgs.lib.optional isClang pkgs.llvmPackages.llvm;
+  } ''
+    mkdir -p $out
     
-    # Install built artifacts
-    find . -name "*.a" -o -name "*.so" | xargs -I {} cp {} $out/lib/ || true
-    find . -perm -111 -type f ! -name "*.so" | xargs -I {} cp {} $out/bin/ || true
+    # Training executables may write scratch files (logs) to the working directory
+    cd "$TMPDIR"
     
-    # Copy headers if they exist
-    if [ -d ../inc ]; then
-      cp -r ../inc/* $out/include/
-    fi
+    ${if isClang then ''
+      export LLVM_PROFILE_FILE="$TMPDIR/raw/%p-%m.profraw"
+    '' else ''
+      export GCOV_PREFIX=$out/gcda
+      export GCOV_PREFIX_STRIP=$(tr -cd / < ${instrumentedModule}/share/pgo-build-dir | wc -c)
+    ''}
     
-    # Copy compile_commands.json
-    if [ -f compile_commands.json ]; then
-      cp compile_commands.json $out/share/
-    fi
+    ${instrumentedModule}/bin/${trainingExecutable} ${pkgs.lib.escapeShellArgs pgoConfig.trainingArgs}
     
-    runHook postInstall
+    ${pkgs.lib.optionalString isClang ''
+      llvm-profdata merge -o $out/default.profdata "$TMPDIR"/raw/*.profraw
+    ''}
   '';
   
-  # Expose module metadata
-  passthru = {
-    moduleName = name;
-    moduleTargets = targets;
-    moduleDependencies = dependencies;  # Original dependency names (strings)
-    resolvedDependencies = internalDeps;  # Actual resolved derivations
-    moduleExternalDeps = externalDeps;  # External dependencies for transitive propagation
-    moduleBuildConfig = finalBuildConfig;
+  optimizedModule = baseModule.overrideAttrs (old: {
+    cmakeLists = moduleCMakeLists { pgo = { phase = "use"; profile = pgoProfile; }; };
+    
+    # GCC looks for each .gcda next to its object file
+    preBuild = (old.preBuild or "") + pkgs.lib.optionalString (!isClang) ''
+      cp -r --no-preserve=mode ${pgoProfile}/gcda/. .
+    '';
+    
+    passthru = old.passthru // {
+      inherit pgoProfile;
+      pgoInstrumented = instrumentedModule;
+    };
+  });
+  
+  # Split build: the libraries in one derivation and every executable in its
+  # own, each from a source tree with only the files it compiles, so editing
+  # a test rebuilds only that test. Editing src/ still rebuilds every
+  # executable derivation; with compilerCache that is mostly relinking
+  libraryTargets = pkgs.lib.filterAttrs (key: target: target.targetType == "library") allTargets;
+  executableTargets = pkgs.lib.filterAttrs (key: target: target.targetType == "executable") allTargets;
+  
+  moduleFiles = filesets: pkgs.lib.fileset.toSource {
+    root = src;
+    fileset = pkgs.lib.fileset.unions filesets;
   };
-}
+  # Private headers in src/ may be included by executables too
+  privateHeaders = pkgs.lib.optional (builtins.pathExists (src + "/src"))
+    (pkgs.lib.fileset.fileFilter (file: file.hasExt "hpp" || file.hasExt "h") (src + "/src"));
+  
+  libraryModule =
+    let librarySrc = moduleFiles (map (dir: pkgs.lib.fileset.maybeMissing (src + "/${dir}")) [ "inc" "src" ]);
+    in baseModule.overrideAttrs {
+      pname = "${name}-library";
+      src = librarySrc;
+      cmakeLists = moduleCMakeLists { cmakeTargets = libraryTargets; cmakeSrc = librarySrc; };
+    };
+  
+  # The library derivation is linked like an internal dependency, ahead of
+  # the module's own dependencies so static link order stays valid
+  executableModule = key: target:
+    let
+      executableSrc = moduleFiles ([ (pkgs.lib.fileset.maybeMissing (src + "/inc")) ]
+        ++ privateHeaders
+        ++ map (file: src + "/${file}") ([ target.entrypoint ] ++ target.sources));
+      executableDeps = pkgs.lib.optional (libraryTargets != {}) libraryModule ++ internalDeps;
+    in baseModule.overrideAttrs (old: {
+      pname = "${name}-${target.name}";
+      src = executableSrc;
+      cmakeLists = moduleCMakeLists {
+        cmakeTargets = { ${key} = target; };
+        cmakeSrc = executableSrc;
+        cmakeDeps = executableDeps;
+      };
+      buildInputs = old.buildInputs ++ pkgs.lib.optional (libraryTargets != {}) libraryModule;
+    });
+  
+  splitParts = pkgs.lib.optional (libraryTargets != {}) libraryModule
+    ++ pkgs.lib.mapAttrsToList executableModule executableTargets;
+  
+  splitModule = pkgs.symlinkJoin {
+    name = "${name}-module-0.1.0";
+    paths = splitParts;
+    nativeBuildInputs = [ pkgs.jq ];
+    
+    # Every part has its own compile database; merge them
+    postBuild = ''
+      rm -f $out/share/compile_commands.json
+      jq -s add ${pkgs.lib.concatMapStringsSep " " (part: "${part}/share/compile_commands.json") splitParts} \
+        > $out/share/compile_commands.json
+    '';
+    
+    passthru = baseModule.passthru // { inherit splitParts; };
+  };
+
+in
+  # PGO rebuilds every target from one profile, so it does not split
+  if pgoConfig.enable then optimizedModule
+  else if finalBuildConfig.features.splitTargets then splitModule
+  else baseModule
@@ -70,6 +70,7 @@ in rec {
       incDir = "${moduleDir}/inc";
       testsDir = "${moduleDir}/tests";
       toolsDir = "${moduleDir}/tools";
+      benchmarksDir = "${moduleDir}/benchmarks";
       
       # Helper to find files with extensions
       findFiles = dir: extensions:
@@ -86,8 +87,35 @@ in rec {
       headers = (findFiles incDir headerExtensions) ++ (findFiles srcDir headerExtensions);
       tests = findFiles testsDir cppExtensions;
       tools = findFiles toolsDir cppExtensions;
+      benchmarks = findFiles benchmarksDir cppExtensions;
     };
   
+  # Turn each top-level benchmarks/*.cpp into a benchmark executable target
+  # named after the file (vector_bench.cpp -> vector-bench). Files already used
+  # as the entrypoint of a declared target are left to that target.
+  discoverBenchmarkTargets = mkExecutable: src: targets:
+    let
+      benchmarksDir = src + "/benchmarks";
+      entries = if src != null && builtins.pathExists benchmarksDir
+                then builtins.readDir benchmarksDir
+                else {};
+      files = lib.attrNames (lib.filterAttrs (file: type:
+        type == "regular" && lib.hasSuffix ".cpp" file
+      ) entries);
+      claimed = map (target: target.entrypoint or null) (lib.attrValues targets);
+      unclaimed = lib.filter (file: !(lib.elem "benchmarks/${file}" claimed)) files;
+    in builtins.listToAttrs (map (file:
+      let name = builtins.replaceStrings [ "_" ] [ "-" ] (lib.removeSuffix ".cpp" file);
+      in {
+        inherit name;
+        value = mkExecutable {
+          inherit name;
+          entrypoint = "benchmarks/${file}";
+          benchmark = true;
+        };
+      }
+    ) unclaimed);
+  
   # Transform store paths to workspace-relative paths
   transformCompileCommands = compileCommandsJson: workspaceRoot:
     let
@@ -153,9 +181,47 @@ in rec {
     in
     kahn graph [] [];
   
+  # Group built modules into levels where every module depends only on
+  # modules in earlier levels; the modules within a level build in parallel
+  dependencyLevels = builtModules:
+    let
+      depth = lib.fix (depthOf: lib.mapAttrs (name: module:
+        lib.foldl' lib.max 0 (map (dep: depthOf.${dep} + 1) (module.passthru.moduleDependencies or []))
+      ) builtModules);
+      maxDepth = lib.foldl' lib.max 0 (lib.attrValues depth);
+    in
+      if builtModules == {} then []
+      else map (level: lib.attrNames (lib.filterAttrs (name: d: d == level) depth)) (lib.range 0 maxDepth);
+  
+  # Combine the `trace` outputs of modules built with features.buildTrace
+  # into one Chrome trace, scheduling each module after its dependencies,
+  # and report the critical path through the monorepo build
+  aggregateBuildTraces = builtModules:
+    let
+      traced = lib.filter (name: builtModules.${name} ? trace)
+        (lib.concatLists (dependencyLevels builtModules));
+      moduleList = pkgs.writeText "build-trace-modules.json" (builtins.toJSON (map (name: {
+        inherit name;
+        dependencies = builtModules.${name}.passthru.moduleDependencies or [];
+        trace = "${builtModules.${name}.trace}";
+      }) traced));
+    in
+      pkgs.runCommand "monorepo-build-trace" { nativeBuildInputs = [ pkgs.python3 ]; } ''
+        python3 ${./build-trace.py} aggregate --modules ${moduleList} --out $out/share/build-trace
+      '';
+  
   # Resolve module dependencies by building them in dependency order
   resolveModuleDependencies = modules: pkgs: cmake-rules:
+    resolveModuleDependenciesWithConfig modules pkgs cmake-rules {};
+  
+  # As above, layering a global build config under each module's own
+  # buildConfig and `moduleOverrides.<name>` over it (later wins):
+  #   { defaultBuildConfig ? {}; moduleOverrides ? {}; }
+  resolveModuleDependenciesWithConfig = modules: pkgs: cmake-rules: globalConfig:
     let
+      globalBuildConfig = globalConfig.defaultBuildConfig or {};
+      moduleOverrides = globalConfig.moduleOverrides or {};
+      
       # Use the topological sort function defined in this same rec set
       sortedModules = topologicalSort modules;
       
@@ -187,6 +253,10 @@ in rec {
             moduleSpecificRules = cmake-rules // {
               mkModule = args: cmake-rules.mkModule (args // {
                 internalDeps = resolvedDeps;
+                buildConfig = lib.foldl' lib.recursiveUpdate globalBuildConfig [
+                  (args.buildConfig or {})
+                  (moduleOverrides.${moduleInfo.name} or {})
+                ];
               });
             };
             
@@ -4,6 +4,10 @@
 let
   inherit (testUtils) assertEqual;
 
+  # Module source with no inc/, src/ or tools/, for tests that only need
+  # generateModuleCMakeLists or mkModule to see a valid source tree
+  emptyModuleSrc = builtins.path { path = ./fixtures/empty-module; name = "empty-module-src"; };
+
 in [
   {
     name = "logging-module-builds";
@@ -105,6 +109,33 @@ in [
         "PASS: internal dependency headers are included for library targets";
   }
 
+  {
+    name = "compile-definitions-cmake-generation";
+    fn = _:
+      let
+        targets = {
+          lib = cmake-rules.mkLibrary { name = "test-lib"; };
+        };
+        
+        cmakeContent = cmake-rules.generateModuleCMakeLists {
+          name = "test-module";
+          inherit targets;
+          dependencies = [];
+          externalDeps = [];
+          fetchContentDeps = [];
+          buildConfig = cmake-rules.defaultBuildConfig // {
+            defines = { LOGGER_ACTIVE_LEVEL = "LOGGER_LEVEL_INFO"; };
+          };
+          src = emptyModuleSrc;
+        };
+        
+        content = builtins.readFile cmakeContent;
+        hasDefinition = builtins.match ".*add_compile_definitions\\(LOGGER_ACTIVE_LEVEL=LOGGER_LEVEL_INFO\\).*" content != null;
+      in
+        assert hasDefinition || throw "CMake should emit add_compile_definitions for buildConfig.defines";
+        "PASS: buildConfig.defines become compile definitions";
+  }
+
   {
     name = "debug-dependency-resolution-real-modules";
     fn = _:
@@ -186,4 +217,437 @@ in [
         assert hasFmt || throw "CMake should include transitive external dependencies (fmt from logging)";
         "PASS: transitive external dependencies are included in CMake generation";
   }
+
+  {
+    name = "benchmark-targets-cmake-generation";
+    fn = _:
+      let
+        targets = {
+          lib = cmake-rules.mkLibrary { name = "test-lib"; };
+          demo = cmake-rules.mkExecutable { name = "demo"; entrypoint = "tools/demo.cpp"; };
+          demo-bench = cmake-rules.mkExecutable {
+            name = "demo-bench";
+            entrypoint = "benchmarks/demo_bench.cpp";
+            benchmark = true;
+          };
+        };
+        
+        generate = targets: builtins.readFile (cmake-rules.generateModuleCMakeLists {
+          name = "test-module";
+          inherit targets;
+          dependencies = [];
+          externalDeps = [];
+          fetchContentDeps = [];
+          buildConfig = cmake-rules.defaultBuildConfig;
+          src = emptyModuleSrc;
+        });
+        
+        content = generate targets;
+        withoutBenchmarks = generate (builtins.removeAttrs targets [ "demo-bench" ]);
+        
+        findsBenchmark = builtins.match ".*find_package\\(benchmark REQUIRED\\).*" content != null;
+        linksBenchmark = builtins.match ".*target_link_libraries\\(demo-bench benchmark::benchmark\\).*" content != null;
+        toolLinksBenchmark = builtins.match ".*target_link_libraries\\(demo benchmark::benchmark\\).*" content != null;
+        findsWithoutBenchmarks = builtins.match ".*find_package\\(benchmark.*" withoutBenchmarks != null;
+      in
+        assert findsBenchmark || throw "CMake should find Google Benchmark when a module has benchmarks";
+        assert linksBenchmark || throw "Benchmark targets should link benchmark::benchmark";
+        assert !toolLinksBenchmark || throw "Only benchmark targets should link Google Benchmark";
+        assert !findsWithoutBenchmarks || throw "Modules without benchmarks should not need Google Benchmark";
+        "PASS: benchmark targets link Google Benchmark";
+  }
+
+  {
+    name = "benchmark-targets-discovered";
+    fn = _:
+      let
+        src = ../../examples/math-utils;
+        discovered = cmake-rules.discoverBenchmarkTargets src {};
+        
+        # A declared target claiming a benchmark source suppresses discovery
+        claimed = cmake-rules.discoverBenchmarkTargets src {
+          custom = cmake-rules.mkExecutable { name = "custom"; entrypoint = "benchmarks/vector_bench.cpp"; };
+        };
+      in
+        assert (discovered ? vector-bench) || throw "vector_bench.cpp should become vector-bench";
+        assert discovered.vector-bench.benchmark || throw "Discovered targets should be benchmarks";
+        assert !(claimed ? vector-bench) || throw "Claimed benchmark sources should not be rediscovered";
+        assertEqual "benchmarks/matrix_bench.cpp" discovered.matrix-bench.entrypoint "Benchmark entrypoint should be the discovered file";
+  }
+
+  {
+    name = "benchmark-check-derivation";
+    fn = _:
+      let
+        mockModule = pkgs.stdenv.mkDerivation {
+          name = "mock-math-utils";
+          dontUnpack = true;
+          installPhase = "mkdir -p $out/bin";
+          passthru = {
+            moduleName = "math-utils";
+            moduleBenchmarks = [ "vector-bench" "matrix-bench" ];
+            moduleSrc = builtins.path { path = ../../examples/math-utils; name = "math-utils-src"; };
+          };
+        };
+        
+        check = cmake-rules.mkBenchmarkCheck { module = mockModule; threshold = 0.2; };
+        explicit = cmake-rules.mkBenchmarkCheck { module = mockModule; baseline = ./default.nix; };
+      in
+        assert check.name == "math-utils-benchmark-check" || throw "Check should be named after the module";
+        assert check.passthru.benchmarks == [ "vector-bench" "matrix-bench" ] || throw "Check should run every module benchmark";
+        assert check.passthru.threshold == 0.2 || throw "Threshold should be configurable";
+        # No benchmark-baseline.json is committed for the example yet
+        assert check.passthru.baseline == null || throw "Missing baseline should not be invented";
+        assert explicit.passthru.baseline != null || throw "An explicit baseline should be used";
+        "PASS: benchmark check derivation is configured from the module";
+  }
+
+  {
+    name = "pgo-cmake-generation";
+    fn = _:
+      let
+        targets = { lib = cmake-rules.mkLibrary { name = "test-lib"; }; };
+        
+        generate = compiler: pgo: builtins.readFile (cmake-rules.generateModuleCMakeLists {
+          name = "test-module";
+          inherit targets;
+          dependencies = [];
+          externalDeps = [];
+          fetchContentDeps = [];
+          buildConfig = pkgs.lib.recursiveUpdate cmake-rules.defaultBuildConfig {
+            inherit compiler;
+            features.pgo = pgo;
+          };
+          src = emptyModuleSrc;
+        });
+        
+        gccGenerate = generate "gcc" { phase = "generate"; };
+        gccUse = generate "gcc" { phase = "use"; };
+        clangUse = generate "clang" { phase = "use"; profile = "/profile"; };
+        plain = generate "gcc" {};
+        
+        has = pattern: content: builtins.match ".*${pattern}.*" content != null;
+      in
+        assert has "-fprofile-generate -fprofile-update=atomic" gccGenerate || throw "GCC instrumented build should use -fprofile-generate";
+        assert has "-fprofile-use -fprofile-partial-training" gccUse || throw "GCC optimized build should use -fprofile-use";
+        assert has "-fprofile-instr-use=/profile/default.profdata" clangUse || throw "Clang optimized build should use the merged profile";
+        assert !(has "-fprofile" plain) || throw "PGO flags should only appear in PGO phases";
+        "PASS: PGO phases produce profile flags";
+  }
+
+  {
+    name = "pgo-requires-training-target";
+    fn = _:
+      let
+        module = cmake-rules.mkModule {
+          name = "pgo-test";
+          src = emptyModuleSrc;
+          targets = { lib = cmake-rules.mkLibrary { name = "pgo-test"; }; };
+          buildConfig.features.pgo.enable = true;
+        };
+        result = builtins.tryEval module.drvPath;
+      in
+        assert !result.success || throw "PGO without a training target should fail evaluation";
+        "PASS: PGO requires a training target";
+  }
+
+  {
+    name = "optimization-cmake-generation";
+    fn = _:
+      let
+        generate = isaVariants: builtins.readFile (cmake-rules.generateModuleCMakeLists {
+          name = "test-module";
+          targets = {
+            lib = cmake-rules.mkLibrary { name = "test-lib"; type = "dynamic"; };
+            tool = cmake-rules.mkExecutable { name = "test-tool"; entrypoint = "tools/tool.cpp"; };
+          };
+          dependencies = [];
+          externalDeps = [];
+          fetchContentDeps = [];
+          buildConfig = pkgs.lib.recursiveUpdate cmake-rules.defaultBuildConfig {
+            optimization = {
+              level = "3";
+              mtune = "generic";
+              noPlt = true;
+              defines.EIGEN_MAX_ALIGN_BYTES = 32;
+              inherit isaVariants;
+            };
+          };
+          src = emptyModuleSrc;
+        });
+        
+        content = generate [ "x86-64-v3" ];
+        has = pattern: builtins.match ".*${pattern}.*" content != null;
+      in
+        assert !(builtins.tryEval (generate [ "haswell" ])).success || throw "ISA variants outside the glibc-hwcaps levels should be rejected";
+        assert has "target_compile_options\\(test-lib PRIVATE -O3 -mtune=generic -fno-plt\\)" || throw "Library should get the optimization flags";
+        assert has "target_compile_definitions\\(test-lib PUBLIC EIGEN_MAX_ALIGN_BYTES=32\\)" || throw "Library optimization defines should be PUBLIC";
+        assert has "target_compile_definitions\\(test-tool PRIVATE EIGEN_MAX_ALIGN_BYTES=32\\)" || throw "Executable optimization defines should be PRIVATE";
+        assert has "add_library\\(test-lib-x86-64-v3 SHARED" || throw "ISA variant library should be generated";
+        assert has "-O3 -march=x86-64-v3" || throw "ISA variant should be built for its -march";
+        assert has "glibc-hwcaps/x86-64-v3" || throw "Shared ISA variant should use the glibc-hwcaps layout";
+        assert !(has "target_link_libraries\\(test-tool PRIVATE[^)]*test-lib-x86-64-v3") || throw "Executables should not link ISA variants";
+        "PASS: optimization profile maps to target-scoped flags";
+  }
+
+  {
+    name = "imported-optimization-defines";
+    fn = _:
+      let
+        mockDep = type: defines: {
+          pname = "core-module";
+          outPath = "/nix/store/mock-core";
+          passthru = {
+            moduleName = "core";
+            moduleLibraryType = type;
+            moduleExternalDeps = [];
+            moduleBuildConfig = pkgs.lib.recursiveUpdate cmake-rules.defaultBuildConfig {
+              optimization = { inherit defines; };
+            };
+          };
+        };
+        
+        generate = dependencies: builtins.readFile (cmake-rules.generateModuleCMakeLists {
+          name = "test-module";
+          targets = { lib = cmake-rules.mkLibrary { name = "test-lib"; }; };
+          inherit dependencies;
+          externalDeps = [];
+          fetchContentDeps = [];
+          buildConfig = cmake-rules.defaultBuildConfig;
+          src = emptyModuleSrc;
+        });
+        
+        aligned = { EIGEN_MAX_ALIGN_BYTES = 32; EIGEN_DONT_VECTORIZE = 1; };
+        has = pattern: content: builtins.match ".*${pattern}.*" content != null;
+      in
+        assert has "INTERFACE_COMPILE_DEFINITIONS \"EIGEN_DONT_VECTORIZE=1;EIGEN_MAX_ALIGN_BYTES=32\"" (generate [ (mockDep "static" aligned) ])
+          || throw "Imported modules should carry their PUBLIC optimization defines";
+        assert has "INTERFACE_COMPILE_DEFINITIONS \"EIGEN_MAX_ALIGN_BYTES=32\"" (generate [ (mockDep "headerOnly" { EIGEN_MAX_ALIGN_BYTES = 32; }) ])
+          || throw "Header-only imports should carry their optimization defines";
+        assert !(has "INTERFACE_COMPILE_DEFINITIONS" (generate [ (mockDep "static" {}) ])) || throw "Modules without defines should not set INTERFACE_COMPILE_DEFINITIONS";
+        "PASS: optimization defines propagate to dependent modules";
+  }
+
+  {
+    name = "module-overrides-apply";
+    fn = _:
+      let
+        moduleDiscovery = cmake-rules.discoverModules ../../examples;
+        buildConfig = import ../../examples/build-config.nix { inherit pkgs; };
+        modules = cmake-rules.resolveModuleDependenciesWithConfig moduleDiscovery pkgs cmake-rules {
+          inherit (buildConfig) moduleOverrides;
+        };
+        mathConfig = modules.math-utils.passthru.moduleBuildConfig;
+      in
+        assert mathConfig.optimization.level == "3" || throw "math-utils override should set the optimization level";
+        assert mathConfig.buildType == "debug" || throw "Override should keep unrelated module settings";
+        assert modules.logging.passthru.moduleBuildConfig.optimization.level == null || throw "Other modules should be unaffected";
+        "PASS: moduleOverrides are layered over module build configs";
+  }
+
+  {
+    name = "precompiled-headers-and-unity-build";
+    fn = _:
+      let
+        content = builtins.readFile (cmake-rules.generateModuleCMakeLists {
+          name = "test-module";
+          targets = {
+            lib = cmake-rules.mkLibrary {
+              name = "test-lib";
+              precompileHeaders = [ "<Eigen/Dense>" ];
+              unityBuild = 4;
+            };
+            tool = cmake-rules.mkExecutable { name = "test-tool"; entrypoint = "tools/tool.cpp"; };
+            bench = cmake-rules.mkExecutable { name = "test-bench"; entrypoint = "benchmarks/bench.cpp"; benchmark = true; };
+          };
+          dependencies = [];
+          externalDeps = [];
+          fetchContentDeps = [];
+          buildConfig = cmake-rules.defaultBuildConfig;
+          src = emptyModuleSrc;
+        });
+        
+        has = pattern: builtins.match ".*${pattern}.*" content != null;
+      in
+        assert has "target_precompile_headers\\(test-lib PRIVATE \"<Eigen/Dense>\"\\)" || throw "Library should precompile its declared headers";
+        assert has "UNITY_BUILD ON UNITY_BUILD_BATCH_SIZE 4" || throw "Unity build should use the requested batch size";
+        assert has "target_precompile_headers\\(test-tool REUSE_FROM test-lib\\)" || throw "Executables should reuse the library PCH";
+        assert !(has "test-bench REUSE_FROM") || throw "Benchmarks should not reuse the library PCH";
+        "PASS: precompiled headers and unity builds are generated";
+  }
+
+  {
+    name = "split-targets-and-compiler-cache";
+    fn = _:
+      let
+        module = cmake-rules.mkModule {
+          name = "split-test";
+          src = ../../examples/math-utils;
+          externalDeps = [ pkgs.eigen ];
+          targets = {
+            lib = cmake-rules.mkLibrary { name = "split-test"; };
+            vector-tests = cmake-rules.mkExecutable { name = "vector-tests"; entrypoint = "tests/vector_test.cpp"; };
+          };
+          buildConfig.features = {
+            splitTargets = true;
+            compilerCache.enable = true;
+          };
+        };
+        parts = module.passthru.splitParts;
+        names = map (part: part.pname) parts;
+        executable = builtins.head (builtins.filter (part: part.pname == "split-test-vector-tests") parts);
+        hasFile = drv: file: builtins.pathExists "${drv.src}/${file}";
+      in
+        assert builtins.elem "split-test-library" names || throw "Libraries should build in their own derivation";
+        assert builtins.elem "split-test-vector-tests" names || throw "Each executable should build in its own derivation";
+        assert !(hasFile (builtins.head parts) "tests/vector_test.cpp") || throw "Library sources should not include tests";
+        assert hasFile executable "tests/vector_test.cpp" || throw "Executable sources should include its entrypoint";
+        assert !(hasFile executable "tests/matrix_test.cpp") || throw "Executable sources should only include what it compiles";
+        assert builtins.elem (builtins.head parts) executable.buildInputs || throw "Executables should link the library derivation";
+        assert builtins.match ".*launchers\\+=\\(ccache\\).*" executable.configurePhase != null || throw "Compiler cache should add ccache to the launchers";
+        assert builtins.match ".*-DCMAKE_CXX_COMPILER_LAUNCHER=.*" executable.configurePhase != null || throw "Launchers should be passed to CMake";
+        "PASS: split targets build in separate derivations";
+  }
+
+  {
+    name = "library-types-and-visibility";
+    fn = _:
+      let
+        mockDep = type: {
+          pname = "core-module";
+          outPath = "/nix/store/mock-core";
+          passthru = {
+            moduleName = "core";
+            moduleLibraryName = "core";
+            moduleLibraryType = type;
+            moduleExternalDeps = [];
+          };
+        };
+        
+        generate = targets: dependencies: builtins.readFile (cmake-rules.generateModuleCMakeLists {
+          name = "test-module";
+          inherit targets dependencies;
+          externalDeps = [];
+          fetchContentDeps = [];
+          buildConfig = cmake-rules.defaultBuildConfig;
+          src = emptyModuleSrc;
+        });
+        
+        staticLib = { lib = cmake-rules.mkLibrary { name = "test-lib"; }; };
+        sharedDep = generate staticLib [ (mockDep "dynamic") ];
+        headerDep = generate staticLib [ (mockDep "headerOnly") ];
+        headerOnly = generate { lib = cmake-rules.mkLibrary { name = "test-lib"; type = "headerOnly"; }; } [ (mockDep "static") ];
+        hidden = generate { lib = cmake-rules.mkLibrary { name = "test-lib"; type = "dynamic"; visibility = "hidden"; }; } [];
+        
+        has = pattern: content: builtins.match ".*${pattern}.*" content != null;
+      in
+        assert has "add_library\\(core SHARED IMPORTED\\)" sharedDep || throw "Dynamic dependencies should be SHARED IMPORTED";
+        assert has "/nix/store/mock-core/lib/libcore.so" sharedDep || throw "Dynamic dependencies should point at the .so";
+        assert has "CMAKE_INSTALL_RPATH_USE_LINK_PATH ON" sharedDep || throw "Shared dependencies should be on the RPATH";
+        assert has "add_library\\(core INTERFACE IMPORTED\\)" headerDep || throw "Header-only dependencies should be INTERFACE IMPORTED";
+        assert has "add_library\\(test-lib INTERFACE\\)" headerOnly || throw "Header-only libraries should be INTERFACE";
+        assert has "target_link_libraries\\(test-lib INTERFACE core\\)" headerOnly || throw "Header-only libraries should link with INTERFACE";
+        assert has "CXX_VISIBILITY_PRESET hidden" hidden || throw "Hidden visibility should set the preset";
+        assert has "generate_export_header\\(test-lib" hidden || throw "Hidden visibility should generate an export header";
+        assert !(has "RPATH" (generate staticLib [])) || throw "Static-only modules should not set an RPATH";
+        "PASS: library types and visibility generate matching CMake";
+  }
+
+  {
+    name = "cross-module-lto";
+    fn = _:
+      let
+        mockDep = lto: {
+          pname = "core-module";
+          outPath = "/nix/store/mock-core";
+          passthru = {
+            moduleName = "core";
+            moduleExternalDeps = [];
+            moduleBuildConfig = pkgs.lib.recursiveUpdate cmake-rules.defaultBuildConfig { features.lto = lto; };
+          };
+        };
+        
+        generate = compiler: lto: dependencies: builtins.readFile (cmake-rules.generateModuleCMakeLists {
+          name = "test-module";
+          targets = { lib = cmake-rules.mkLibrary { name = "test-lib"; }; };
+          inherit dependencies;
+          externalDeps = [];
+          fetchContentDeps = [];
+          buildConfig = pkgs.lib.recursiveUpdate cmake-rules.defaultBuildConfig {
+            inherit compiler;
+            features.lto = lto;
+          };
+          src = emptyModuleSrc;
+        });
+        
+        gccFat = generate "gcc" true [];
+        gccThin = generate "gcc" "thin" [];
+        clangThin = generate "clang" "thin" [];
+        
+        has = pattern: content: builtins.match ".*${pattern}.*" content != null;
+      in
+        assert has "-flto=auto -ffat-lto-objects" gccFat || throw "lto = true should produce fat objects";
+        assert has "bin/gcc-ar" gccFat || throw "GCC LTO archives should use gcc-ar";
+        assert has "-fno-fat-lto-objects" gccThin || throw "Thin GCC LTO should drop machine code";
+        assert has "-flto=thin" clangThin && has "bin/llvm-ar" clangThin || throw "Clang thin LTO should use ThinLTO and llvm-ar";
+        assert has "-fuse-ld=lld" clangThin || throw "Clang LTO should link with lld";
+        assert !(has "gcc-ar" (generate "gcc" false [])) || throw "Non-LTO builds should keep the default archiver";
+        assert (builtins.tryEval (generate "gcc" false [ (mockDep "fat") ])).success || throw "Fat LTO modules should link without LTO";
+        assert !(builtins.tryEval (generate "gcc" false [ (mockDep "thin") ])).success || throw "Thin LTO modules should require LTO in consumers";
+        "PASS: LTO modes generate cross-module flags and archivers";
+  }
+
+  {
+    name = "dependency-levels";
+    fn = _:
+      let
+        mock = deps: { passthru.moduleDependencies = deps; };
+        levels = cmake-rules.dependencyLevels {
+          logging = mock [];
+          config = mock [];
+          math-utils = mock [ "logging" ];
+          app = mock [ "math-utils" "config" ];
+        };
+      in
+        assertEqual [ [ "config" "logging" ] [ "math-utils" ] [ "app" ] ] levels "Modules should be grouped by dependency depth";
+  }
+
+  {
+    name = "build-trace";
+    fn = _:
+      let
+        generate = compiler: builtins.readFile (cmake-rules.generateModuleCMakeLists {
+          name = "test-module";
+          targets = { lib = cmake-rules.mkLibrary { name = "test-lib"; }; };
+          dependencies = [];
+          externalDeps = [];
+          fetchContentDeps = [];
+          buildConfig = pkgs.lib.recursiveUpdate cmake-rules.defaultBuildConfig {
+            inherit compiler;
+            features.buildTrace = true;
+          };
+          src = emptyModuleSrc;
+        });
+        
+        module = cmake-rules.mkModule {
+          name = "trace-test";
+          src = emptyModuleSrc;
+          targets = { lib = cmake-rules.mkLibrary { name = "trace-test"; }; };
+          buildConfig.features.buildTrace = true;
+        };
+        makeModule = (builtins.tryEval (cmake-rules.mkModule {
+          name = "trace-make";
+          src = emptyModuleSrc;
+          targets = { lib = cmake-rules.mkLibrary { name = "trace-make"; }; };
+          buildConfig = { generator = "make"; features.buildTrace = true; };
+        }).drvPath).success;
+        
+        has = pattern: content: builtins.match ".*${pattern}.*" content != null;
+      in
+        assert has "-ftime-trace" (generate "clang") || throw "Clang trace builds should use -ftime-trace";
+        assert has "-ftime-report" (generate "gcc") || throw "GCC trace builds should use -ftime-report";
+        assert module.outputs == [ "out" "trace" ] || throw "Trace builds should add a trace output";
+        assert !makeModule || throw "Build tracing should require Ninja";
+        "PASS: build tracing adds compiler reports and a trace output";
+  }
 ]